@@ -0,0 +1,154 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+#include "TMatrix.h"
+
+// Исполнитель задач -
+// абстракция, на которой запускаются асинхронные операции
+class TExecutor
+{
+public:
+    virtual ~TExecutor() = default;
+
+    // поставить задачу в очередь
+    virtual void Submit(std::function<void()> task) = 0;
+
+    // число задач, которые могут выполняться одновременно
+    virtual size_t GetConcurrency() const noexcept = 0;
+};
+
+// Пул потоков фиксированного размера
+class TThreadPoolExecutor : public TExecutor
+{
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void WorkerLoop();
+public:
+    explicit TThreadPoolExecutor(size_t threads = std::thread::hardware_concurrency());
+    ~TThreadPoolExecutor();
+
+    TThreadPoolExecutor(const TThreadPoolExecutor&) = delete;
+    TThreadPoolExecutor& operator=(const TThreadPoolExecutor&) = delete;
+
+    void Submit(std::function<void()> task) override;
+    size_t GetConcurrency() const noexcept override { return workers.size(); }
+};
+
+// Исполнитель, выполняющий задачу сразу в вызывающем потоке
+class TInlineExecutor : public TExecutor
+{
+public:
+    void Submit(std::function<void()> task) override { task(); }
+    size_t GetConcurrency() const noexcept override { return 1; }
+};
+
+// исполнитель по умолчанию (общий пул на все ядра)
+TExecutor& DefaultExecutor();
+
+// Исключение, которым завершается отменённая операция
+class TOperationCancelled : public std::runtime_error
+{
+public:
+    TOperationCancelled() : std::runtime_error("Operation was cancelled") {}
+};
+
+namespace async_detail
+{
+    // Общее состояние асинхронной операции
+    template<typename R>
+    struct TAsyncState
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool ready = false;
+        std::optional<R> value;
+        std::exception_ptr error;
+        std::vector<std::function<void()>> continuations;
+
+        std::stop_source stop;
+        std::atomic<size_t> done{ 0 };
+        std::atomic<size_t> total{ 0 };
+
+        void SetValue(R&& v);
+        void SetError(std::exception_ptr e);
+        void OnReady(std::function<void()> f);
+    };
+}
+
+// Результат асинхронной операции -
+// future с отменой, опросом прогресса и продолжениями
+template<typename R>
+class TAsyncResult
+{
+    std::shared_ptr<async_detail::TAsyncState<R>> state;
+public:
+    TAsyncResult() : state(std::make_shared<async_detail::TAsyncState<R>>()) {}
+
+    // готовность и ожидание
+    bool IsReady() const;
+    void Wait() const;
+    R& Get() const;
+
+    // отмена
+    void Cancel() noexcept;
+    bool IsCancelled() const noexcept;
+    std::stop_token GetStopToken() const noexcept { return state->stop.get_token(); }
+
+    // прогресс в диапазоне [0, 1]
+    double GetProgress() const noexcept;
+
+    // продолжение: f(R&) выполняется на ex после готовности результата
+    template<typename F>
+    auto Then(F f, TExecutor& ex = DefaultExecutor()) const
+        -> TAsyncResult<std::decay_t<std::invoke_result_t<F, R&>>>;
+
+    // вызвать f() после готовности (в том потоке, который завершил операцию)
+    void OnReady(std::function<void()> f) const { state->OnReady(std::move(f)); }
+
+    // доступ к состоянию для реализаций операций
+    const std::shared_ptr<async_detail::TAsyncState<R>>& GetState() const noexcept { return state; }
+
+#if defined(__cpp_impl_coroutine)
+    // поддержка co_await
+    bool await_ready() const { return IsReady(); }
+    void await_suspend(std::coroutine_handle<> h) const { state->OnReady([h]() { h.resume(); }); }
+    R& await_resume() const { return Get(); }
+#endif
+};
+
+// асинхронные матричные операции над операндами, живущими до готовности результата
+// (матрицы одной раскладки; результат побитово совпадает с синхронными операторами)
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncMultiply(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b, TExecutor& ex = DefaultExecutor());
+template<typename T, typename L>
+TAsyncResult<TDynamicVector<T>> AsyncMultiply(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& v, TExecutor& ex = DefaultExecutor());
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncAdd(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b, TExecutor& ex = DefaultExecutor());
+
+// те же операции над результатами других операций (конвейер)
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncMultiply(TAsyncResult<TDynamicMatrix<T, L>> a, TAsyncResult<TDynamicMatrix<T, L>> b, TExecutor& ex = DefaultExecutor());
+template<typename T, typename L>
+TAsyncResult<TDynamicVector<T>> AsyncMultiply(TAsyncResult<TDynamicMatrix<T, L>> a, TAsyncResult<TDynamicVector<T>> v, TExecutor& ex = DefaultExecutor());
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncAdd(TAsyncResult<TDynamicMatrix<T, L>> a, TAsyncResult<TDynamicMatrix<T, L>> b, TExecutor& ex = DefaultExecutor());
+
+#include "TAsync.tpp"
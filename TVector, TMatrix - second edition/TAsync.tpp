@@ -0,0 +1,679 @@
+﻿// -------------------- Thread pool executor --------------------
+
+/**
+ * @brief Конструктор пула потоков.
+ *
+ * Запускает threads рабочих потоков, разбирающих общую очередь задач.
+ *
+ * @param threads Количество рабочих потоков (0 трактуется как 1).
+ */
+inline TThreadPoolExecutor::TThreadPoolExecutor(size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = 1;
+    }
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+/**
+ * @brief Деструктор пула потоков.
+ *
+ * Дожидается выполнения всех поставленных задач и останавливает потоки.
+ */
+inline TThreadPoolExecutor::~TThreadPoolExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+
+    for (std::thread& w : workers)
+    {
+        w.join();
+    }
+}
+
+/**
+ * @brief Постановка задачи в очередь пула.
+ *
+ * @param task Задача для выполнения на одном из рабочих потоков.
+ */
+inline void TThreadPoolExecutor::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        tasks.push_back(std::move(task));
+    }
+    cv.notify_one();
+}
+
+/**
+ * @brief Цикл рабочего потока.
+ *
+ * Извлекает задачи из очереди, пока пул не остановлен и очередь не пуста.
+ */
+inline void TThreadPoolExecutor::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+            {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+/**
+ * @brief Исполнитель по умолчанию.
+ *
+ * Общий пул потоков по числу аппаратных ядер, создаётся при первом обращении.
+ *
+ * @return Ссылка на общий исполнитель.
+ */
+inline TExecutor& DefaultExecutor()
+{
+    static TThreadPoolExecutor pool;
+    return pool;
+}
+
+
+// -------------------- Shared state --------------------
+
+namespace async_detail
+{
+    /**
+     * @brief Завершение операции значением.
+     *
+     * Сохраняет результат, будит ожидающих и запускает продолжения.
+     * Повторное завершение игнорируется.
+     *
+     * @tparam R Тип результата.
+     * @param v Результат операции.
+     */
+    template<typename R>
+    void TAsyncState<R>::SetValue(R&& v)
+    {
+        std::vector<std::function<void()>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (ready)
+            {
+                return;
+            }
+            value.emplace(std::move(v));
+            ready = true;
+            pending.swap(continuations);
+        }
+        cv.notify_all();
+
+        for (auto& f : pending)
+        {
+            f();
+        }
+    }
+
+    /**
+     * @brief Завершение операции ошибкой.
+     *
+     * @tparam R Тип результата.
+     * @param e Исключение, которое будет выброшено из Get().
+     */
+    template<typename R>
+    void TAsyncState<R>::SetError(std::exception_ptr e)
+    {
+        std::vector<std::function<void()>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (ready)
+            {
+                return;
+            }
+            error = e;
+            ready = true;
+            pending.swap(continuations);
+        }
+        cv.notify_all();
+
+        for (auto& f : pending)
+        {
+            f();
+        }
+    }
+
+    /**
+     * @brief Регистрация продолжения.
+     *
+     * Если операция уже завершена, f вызывается немедленно в текущем потоке,
+     * иначе — в потоке, который завершит операцию.
+     *
+     * @tparam R Тип результата.
+     * @param f Продолжение.
+     */
+    template<typename R>
+    void TAsyncState<R>::OnReady(std::function<void()> f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!ready)
+            {
+                continuations.push_back(std::move(f));
+                return;
+            }
+        }
+        f();
+    }
+
+    /**
+     * @brief Запуск построчного ядра на исполнителе.
+     *
+     * Делит строки [0, count) на блоки (по несколько на каждый поток исполнителя),
+     * перед каждой строкой проверяет запрос отмены и обновляет счётчик прогресса.
+     * Последний завершившийся блок публикует результат finish() или ошибку.
+     *
+     * @param st Состояние операции.
+     * @param count Количество строк.
+     * @param ex Исполнитель.
+     * @param row Ядро, вычисляющее одну строку: row(i).
+     * @param finish Функция, возвращающая готовый результат.
+     * @param keep Владение входными данными на время вычисления (может быть пустым).
+     */
+    template<typename R, typename Row, typename Finish>
+    void LaunchRows(const std::shared_ptr<TAsyncState<R>>& st, size_t count, TExecutor& ex,
+        Row row, Finish finish, std::shared_ptr<void> keep)
+    {
+        struct TChunks
+        {
+            std::atomic<size_t> remaining{ 0 };
+            std::mutex mtx;
+            std::exception_ptr error;
+        };
+
+        size_t chunks = std::min(count, std::max<size_t>(1, ex.GetConcurrency() * 4));
+        auto sh = std::make_shared<TChunks>();
+        sh->remaining = chunks;
+        st->total = count;
+
+        for (size_t c = 0; c < chunks; c++)
+        {
+            size_t begin = count * c / chunks;
+            size_t end = count * (c + 1) / chunks;
+
+            ex.Submit([st, sh, begin, end, row, finish, keep]() mutable
+            {
+                std::stop_token token = st->stop.get_token();
+                try
+                {
+                    for (size_t i = begin; i < end && !token.stop_requested(); i++)
+                    {
+                        row(i);
+                        st->done.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(sh->mtx);
+                    if (!sh->error)
+                    {
+                        sh->error = std::current_exception();
+                    }
+                }
+
+                if (sh->remaining.fetch_sub(1) != 1)
+                {
+                    return;
+                }
+
+                if (sh->error)
+                {
+                    st->SetError(sh->error);
+                }
+                else if (token.stop_requested())
+                {
+                    st->SetError(std::make_exception_ptr(TOperationCancelled()));
+                }
+                else
+                {
+                    try
+                    {
+                        st->SetValue(finish());
+                    }
+                    catch (...)
+                    {
+                        st->SetError(std::current_exception());
+                    }
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Запуск операции после готовности двух зависимостей.
+     *
+     * Не блокирует потоки: ожидание выражено продолжениями. Ошибка любой
+     * зависимости переносится в результат; отмена результата до готовности
+     * зависимостей завершает его TOperationCancelled.
+     *
+     * @param a Первая зависимость.
+     * @param b Вторая зависимость.
+     * @param launch Функция launch(a, b, dst, keep), запускающая вычисление.
+     * @return Результат зависимой операции.
+     */
+    template<typename R, typename A, typename B, typename Launch>
+    TAsyncResult<R> WhenBoth(TAsyncResult<A> a, TAsyncResult<B> b, Launch launch)
+    {
+        TAsyncResult<R> result;
+        auto dst = result.GetState();
+        auto pending = std::make_shared<std::atomic<int>>(2);
+
+        auto step = [a, b, dst, pending, launch]()
+        {
+            if (pending->fetch_sub(1) != 1)
+            {
+                return;
+            }
+
+            if (a.GetState()->error)
+            {
+                dst->SetError(a.GetState()->error);
+            }
+            else if (b.GetState()->error)
+            {
+                dst->SetError(b.GetState()->error);
+            }
+            else if (dst->stop.stop_requested())
+            {
+                dst->SetError(std::make_exception_ptr(TOperationCancelled()));
+            }
+            else
+            {
+                try
+                {
+                    auto keep = std::make_shared<std::pair<TAsyncResult<A>, TAsyncResult<B>>>(a, b);
+                    launch(a.Get(), b.Get(), dst, keep);
+                }
+                catch (...)
+                {
+                    dst->SetError(std::current_exception());
+                }
+            }
+        };
+
+        a.OnReady(step);
+        b.OnReady(step);
+        return result;
+    }
+
+    /**
+     * @brief Запуск умножения матриц.
+     *
+     * Линия результата l (строка для TRowMajor, столбец для TColMajor)
+     * вычисляется ядром operator* (matrix_detail::GemmLineRange), так что
+     * результат побитово совпадает с синхронным.
+     *
+     * @throws std::invalid_argument если размеры матриц не совпадают.
+     */
+    template<typename T, typename L>
+    void LaunchMultiply(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b,
+        const std::shared_ptr<TAsyncState<TDynamicMatrix<T, L>>>& dst, TExecutor& ex, std::shared_ptr<void> keep)
+    {
+        if (a.GetSize() != b.GetSize())
+        {
+            throw std::invalid_argument("Matrices must be of the same size (not mathematically though) for multiplication");
+        }
+
+        size_t n = a.GetSize();
+        auto out = std::make_shared<TDynamicMatrix<T, L>>(n);
+        const TDynamicVector<T>* pa = &a.Line(0);
+        const TDynamicVector<T>* pb = &b.Line(0);
+        TDynamicVector<T>* pc = &out->Line(0);
+
+        LaunchRows(dst, n, ex,
+            [pa, pb, pc, n](size_t l)
+            {
+                matrix_detail::GemmLineRange(n, l, l + 1, pa, pb, pc, L::IsRowMajor);
+            },
+            [out]() { return std::move(*out); },
+            keep);
+    }
+
+    /**
+     * @brief Запуск умножения матрицы на вектор.
+     *
+     * Элемент результата i вычисляется matrix_detail::GemvRowRange (побитово
+     * как operator*).
+     *
+     * @throws std::invalid_argument если размер вектора не совпадает с размером матрицы.
+     */
+    template<typename T, typename L>
+    void LaunchMultiply(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& v,
+        const std::shared_ptr<TAsyncState<TDynamicVector<T>>>& dst, TExecutor& ex, std::shared_ptr<void> keep)
+    {
+        if (a.GetSize() != v.GetSize())
+        {
+            throw std::invalid_argument("Matrix columns must match vector size for multiplication");
+        }
+
+        size_t n = a.GetSize();
+        auto out = std::make_shared<TDynamicVector<T>>(n);
+        const TDynamicVector<T>* pa = &a.Line(0);
+        const T* pv = &v[0];
+        T* py = &(*out)[0];
+
+        LaunchRows(dst, n, ex,
+            [pa, pv, py, n](size_t i)
+            {
+                matrix_detail::GemvRowRange(n, i, i + 1, pa, L::IsRowMajor, pv, py);
+            },
+            [out]() { return std::move(*out); },
+            keep);
+    }
+
+    /**
+     * @brief Запуск сложения матриц.
+     *
+     * Линии хранения складываются независимо (матрицы одной раскладки).
+     *
+     * @throws std::invalid_argument если размеры матриц не совпадают.
+     */
+    template<typename T, typename L>
+    void LaunchAdd(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b,
+        const std::shared_ptr<TAsyncState<TDynamicMatrix<T, L>>>& dst, TExecutor& ex, std::shared_ptr<void> keep)
+    {
+        if (a.GetSize() != b.GetSize())
+        {
+            throw std::invalid_argument("Matrices must be of the same size for addition");
+        }
+
+        size_t n = a.GetSize();
+        auto out = std::make_shared<TDynamicMatrix<T, L>>(n);
+        const TDynamicVector<T>* pa = &a.Line(0);
+        const TDynamicVector<T>* pb = &b.Line(0);
+        TDynamicVector<T>* pc = &out->Line(0);
+
+        LaunchRows(dst, n, ex,
+            [pa, pb, pc, n](size_t l)
+            {
+                const T* al = &pa[l][0];
+                const T* bl = &pb[l][0];
+                T* cl = &pc[l][0];
+                for (size_t e = 0; e < n; e++)
+                {
+                    cl[e] = al[e] + bl[e];
+                }
+            },
+            [out]() { return std::move(*out); },
+            keep);
+    }
+}
+
+
+// -------------------- Async result --------------------
+
+/**
+ * @brief Проверка готовности результата.
+ *
+ * @return true если операция завершена (значением или ошибкой).
+ */
+template<typename R>
+bool TAsyncResult<R>::IsReady() const
+{
+    std::lock_guard<std::mutex> lock(state->mtx);
+    return state->ready;
+}
+
+/**
+ * @brief Блокирующее ожидание завершения операции.
+ */
+template<typename R>
+void TAsyncResult<R>::Wait() const
+{
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->cv.wait(lock, [this]() { return state->ready; });
+}
+
+/**
+ * @brief Получение результата.
+ *
+ * Дожидается завершения операции.
+ *
+ * @return Ссылка на результат, хранящийся в общем состоянии.
+ * @throws TOperationCancelled если операция была отменена.
+ * @throws Исключение, с которым завершилась операция.
+ */
+template<typename R>
+R& TAsyncResult<R>::Get() const
+{
+    Wait();
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+    return *state->value;
+}
+
+/**
+ * @brief Запрос отмены.
+ *
+ * Ядро прекращает работу перед следующей строкой; результат завершается
+ * исключением TOperationCancelled. Уже завершённую операцию не затрагивает.
+ */
+template<typename R>
+void TAsyncResult<R>::Cancel() noexcept
+{
+    state->stop.request_stop();
+}
+
+/**
+ * @brief Проверка, была ли запрошена отмена.
+ */
+template<typename R>
+bool TAsyncResult<R>::IsCancelled() const noexcept
+{
+    return state->stop.stop_requested();
+}
+
+/**
+ * @brief Опрос прогресса.
+ *
+ * @return Доля обработанных строк; 1 для завершённых операций без построчного ядра.
+ */
+template<typename R>
+double TAsyncResult<R>::GetProgress() const noexcept
+{
+    size_t total = state->total.load();
+    if (total == 0)
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        return state->ready ? 1.0 : 0.0;
+    }
+    return static_cast<double>(state->done.load()) / static_cast<double>(total);
+}
+
+/**
+ * @brief Продолжение операции.
+ *
+ * После готовности результата ставит f(результат) в очередь ex. Ошибка или
+ * отмена текущей операции переносится в возвращаемый результат без вызова f.
+ *
+ * @param f Функция от R&.
+ * @param ex Исполнитель продолжения.
+ * @return Результат продолжения.
+ */
+template<typename R>
+template<typename F>
+auto TAsyncResult<R>::Then(F f, TExecutor& ex) const
+    -> TAsyncResult<std::decay_t<std::invoke_result_t<F, R&>>>
+{
+    using U = std::decay_t<std::invoke_result_t<F, R&>>;
+    static_assert(!std::is_void<U>::value, "Continuation must return a value");
+
+    TAsyncResult<U> next;
+    auto src = state;
+    auto dst = next.GetState();
+    TExecutor* pex = &ex;
+
+    state->OnReady([src, dst, f, pex]()
+    {
+        pex->Submit([src, dst, f]() mutable
+        {
+            if (src->error)
+            {
+                dst->SetError(src->error);
+                return;
+            }
+            if (dst->stop.stop_requested())
+            {
+                dst->SetError(std::make_exception_ptr(TOperationCancelled()));
+                return;
+            }
+            try
+            {
+                dst->SetValue(f(*src->value));
+            }
+            catch (...)
+            {
+                dst->SetError(std::current_exception());
+            }
+        });
+    });
+    return next;
+}
+
+
+// -------------------- Async matrix operations --------------------
+
+/**
+ * @brief Асинхронное умножение матриц.
+ *
+ * a и b должны оставаться живыми до готовности результата.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матриц.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @param ex Исполнитель.
+ * @throws std::invalid_argument если размеры матриц не совпадают.
+ * @return Результат a * b.
+ */
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncMultiply(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b, TExecutor& ex)
+{
+    TAsyncResult<TDynamicMatrix<T, L>> result;
+    async_detail::LaunchMultiply(a, b, result.GetState(), ex, nullptr);
+    return result;
+}
+
+/**
+ * @brief Асинхронное умножение матрицы на вектор.
+ *
+ * a и v должны оставаться живыми до готовности результата.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param a Матрица.
+ * @param v Вектор.
+ * @param ex Исполнитель.
+ * @throws std::invalid_argument если размер вектора не совпадает с размером матрицы.
+ * @return Результат a * v.
+ */
+template<typename T, typename L>
+TAsyncResult<TDynamicVector<T>> AsyncMultiply(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& v, TExecutor& ex)
+{
+    TAsyncResult<TDynamicVector<T>> result;
+    async_detail::LaunchMultiply(a, v, result.GetState(), ex, nullptr);
+    return result;
+}
+
+/**
+ * @brief Асинхронное сложение матриц.
+ *
+ * a и b должны оставаться живыми до готовности результата.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матриц.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @param ex Исполнитель.
+ * @throws std::invalid_argument если размеры матриц не совпадают.
+ * @return Результат a + b.
+ */
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncAdd(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b, TExecutor& ex)
+{
+    TAsyncResult<TDynamicMatrix<T, L>> result;
+    async_detail::LaunchAdd(a, b, result.GetState(), ex, nullptr);
+    return result;
+}
+
+/**
+ * @brief Умножение матриц в конвейере.
+ *
+ * Запускается, когда готовы обе зависимости; до этого не занимает потоков
+ * исполнителя, поэтому независимые ветви конвейера выполняются параллельно.
+ * Ошибка несовпадения размеров возвращается через результат.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матриц.
+ * @return Результат a * b.
+ */
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncMultiply(TAsyncResult<TDynamicMatrix<T, L>> a, TAsyncResult<TDynamicMatrix<T, L>> b, TExecutor& ex)
+{
+    TExecutor* pex = &ex;
+    return async_detail::WhenBoth<TDynamicMatrix<T, L>>(a, b,
+        [pex](const TDynamicMatrix<T, L>& x, const TDynamicMatrix<T, L>& y, const auto& dst, std::shared_ptr<void> keep)
+        {
+            async_detail::LaunchMultiply(x, y, dst, *pex, keep);
+        });
+}
+
+/**
+ * @brief Умножение матрицы на вектор в конвейере.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @return Результат a * v.
+ */
+template<typename T, typename L>
+TAsyncResult<TDynamicVector<T>> AsyncMultiply(TAsyncResult<TDynamicMatrix<T, L>> a, TAsyncResult<TDynamicVector<T>> v, TExecutor& ex)
+{
+    TExecutor* pex = &ex;
+    return async_detail::WhenBoth<TDynamicVector<T>>(a, v,
+        [pex](const TDynamicMatrix<T, L>& x, const TDynamicVector<T>& y, const auto& dst, std::shared_ptr<void> keep)
+        {
+            async_detail::LaunchMultiply(x, y, dst, *pex, keep);
+        });
+}
+
+/**
+ * @brief Сложение матриц в конвейере.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матриц.
+ * @return Результат a + b.
+ */
+template<typename T, typename L>
+TAsyncResult<TDynamicMatrix<T, L>> AsyncAdd(TAsyncResult<TDynamicMatrix<T, L>> a, TAsyncResult<TDynamicMatrix<T, L>> b, TExecutor& ex)
+{
+    TExecutor* pex = &ex;
+    return async_detail::WhenBoth<TDynamicMatrix<T, L>>(a, b,
+        [pex](const TDynamicMatrix<T, L>& x, const TDynamicMatrix<T, L>& y, const auto& dst, std::shared_ptr<void> keep)
+        {
+            async_detail::LaunchAdd(x, y, dst, *pex, keep);
+        });
+}
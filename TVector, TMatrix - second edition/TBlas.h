@@ -0,0 +1,31 @@
+﻿#pragma once
+#include <stdexcept>
+#include "TMatrix.h"
+
+// Операции в стиле BLAS -
+// результат записывается в память вызывающего, без выделения памяти
+
+// уровень 1: вектор-вектор
+template<typename T>
+void axpy(const T& alpha, const TDynamicVector<T>& x, TDynamicVector<T>& y);   // y = alpha * x + y
+template<typename T>
+void scal(const T& alpha, TDynamicVector<T>& x) noexcept;                      // x = alpha * x
+template<typename T>
+T dot(const TDynamicVector<T>& x, const TDynamicVector<T>& y);                 // x^T * y
+template<typename T>
+T dotc(const TDynamicVector<T>& x, const TDynamicVector<T>& y);                // x^H * y (сопряжённое)
+
+// уровень 2: матрица-вектор (матрица с любой раскладкой)
+template<typename T, typename L>
+void gemv(const T& alpha, const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& x,
+    const T& beta, TDynamicVector<T>& y);                                       // y = alpha * A * x + beta * y
+template<typename T, typename L>
+void ger(const T& alpha, const TDynamicVector<T>& x, const TDynamicVector<T>& y,
+    TDynamicMatrix<T, L>& a);                                                   // A = alpha * x * y^T + A
+
+// уровень 3: матрица-матрица (раскладки операндов и результата независимы)
+template<typename T, typename LA, typename LB, typename LC>
+void gemm(const T& alpha, const TDynamicMatrix<T, LA>& a, const TDynamicMatrix<T, LB>& b,
+    const T& beta, TDynamicMatrix<T, LC>& c);                                   // C = alpha * A * B + beta * C
+
+#include "TBlas.tpp"
@@ -0,0 +1,237 @@
+﻿// -------------------- Level 1 --------------------
+
+/**
+ * @brief y = alpha * x + y.
+ *
+ * @tparam T Тип элементов.
+ * @param alpha Скаляр.
+ * @param x Входной вектор.
+ * @param y Вектор-результат (изменяется на месте).
+ * @throws std::invalid_argument если размеры векторов не совпадают.
+ */
+template<typename T>
+void axpy(const T& alpha, const TDynamicVector<T>& x, TDynamicVector<T>& y)
+{
+    TTRACE_SCOPE("axpy", x.GetSize());
+    if (x.GetSize() != y.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for axpy");
+    }
+
+    size_t n = x.GetSize();
+    const T* px = &x[0];
+    T* py = &y[0];
+    for (size_t i = 0; i < n; i++)
+    {
+        py[i] += vector_detail::Mul(alpha, px[i]);
+    }
+}
+
+/**
+ * @brief x = alpha * x.
+ *
+ * @tparam T Тип элементов.
+ * @param alpha Скаляр.
+ * @param x Вектор (изменяется на месте).
+ */
+template<typename T>
+void scal(const T& alpha, TDynamicVector<T>& x) noexcept
+{
+    TTRACE_SCOPE("scal", x.GetSize());
+    size_t n = x.GetSize();
+    T* px = &x[0];
+    for (size_t i = 0; i < n; i++)
+    {
+        px[i] = vector_detail::Mul(px[i], alpha);
+    }
+}
+
+/**
+ * @brief Скалярное произведение x^T * y.
+ *
+ * @tparam T Тип элементов.
+ * @param x Левый вектор.
+ * @param y Правый вектор.
+ * @throws std::invalid_argument если размеры векторов не совпадают.
+ * @return Скалярное произведение.
+ */
+template<typename T>
+T dot(const TDynamicVector<T>& x, const TDynamicVector<T>& y)
+{
+    TTRACE_SCOPE("dot", x.GetSize());
+    if (x.GetSize() != y.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for dot product");
+    }
+
+    size_t n = x.GetSize();
+    const T* px = &x[0];
+    const T* py = &y[0];
+    T result = T();
+    for (size_t i = 0; i < n; i++)
+    {
+        result += vector_detail::Mul(px[i], py[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Сопряжённое скалярное произведение x^H * y = sum(conj(x[i]) * y[i]).
+ *
+ * Для вещественных T совпадает с dot.
+ *
+ * @tparam T Тип элементов (вещественный или std::complex).
+ * @param x Левый (сопрягаемый) вектор.
+ * @param y Правый вектор.
+ * @throws std::invalid_argument если размеры векторов не совпадают.
+ * @return Сопряжённое скалярное произведение.
+ */
+template<typename T>
+T dotc(const TDynamicVector<T>& x, const TDynamicVector<T>& y)
+{
+    TTRACE_SCOPE("dotc", x.GetSize());
+    if (x.GetSize() != y.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for dot product");
+    }
+
+    size_t n = x.GetSize();
+    const T* px = &x[0];
+    const T* py = &y[0];
+    T result = T();
+    for (size_t i = 0; i < n; i++)
+    {
+        result += vector_detail::Mul(vector_detail::Conj(px[i]), py[i]);
+    }
+    return result;
+}
+
+
+// -------------------- Level 2 --------------------
+
+/**
+ * @brief y = alpha * A * x + beta * y.
+ *
+ * При beta == 0 прежнее содержимое y не читается (как в BLAS). Порядок
+ * обхода выбирается по раскладке A (см. matrix_detail::GemvLines).
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param alpha Множитель произведения.
+ * @param a Матрица.
+ * @param x Входной вектор; не должен совпадать с y.
+ * @param beta Множитель прежнего значения y.
+ * @param y Вектор-результат (изменяется на месте).
+ * @throws std::invalid_argument если размеры несовместимы или x и y — один объект.
+ */
+template<typename T, typename L>
+void gemv(const T& alpha, const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& x,
+    const T& beta, TDynamicVector<T>& y)
+{
+    TTRACE_SCOPE("gemv", a.GetSize());
+    if (a.GetSize() != x.GetSize() || a.GetSize() != y.GetSize())
+    {
+        throw std::invalid_argument("Matrix columns must match vector size for gemv");
+    }
+
+    if (&x == &y)
+    {
+        throw std::invalid_argument("Input and output vectors of gemv must not alias");
+    }
+
+    size_t n = a.GetSize();
+    T* py = &y[0];
+    const bool zero_beta = (beta == T());
+    for (size_t i = 0; i < n; i++)
+    {
+        py[i] = zero_beta ? T() : vector_detail::Mul(beta, py[i]);
+    }
+    matrix_detail::GemvLines(n, alpha, &a.Line(0), L::IsRowMajor, &x[0], py);
+}
+
+/**
+ * @brief A = alpha * x * y^T + A (внешнее произведение ранга 1).
+ *
+ * Для TRowMajor к строке i добавляется (alpha * x[i]) * y, для TColMajor
+ * к столбцу j — (alpha * y[j]) * x.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param alpha Скаляр.
+ * @param x Вектор-столбец.
+ * @param y Вектор-строка.
+ * @param a Матрица-результат (изменяется на месте).
+ * @throws std::invalid_argument если размеры несовместимы.
+ */
+template<typename T, typename L>
+void ger(const T& alpha, const TDynamicVector<T>& x, const TDynamicVector<T>& y,
+    TDynamicMatrix<T, L>& a)
+{
+    TTRACE_SCOPE("ger", a.GetSize());
+    if (a.GetSize() != x.GetSize() || a.GetSize() != y.GetSize())
+    {
+        throw std::invalid_argument("Matrix size must match vector sizes for ger");
+    }
+
+    size_t n = a.GetSize();
+    const T* outer = L::IsRowMajor ? &x[0] : &y[0];
+    const T* inner = L::IsRowMajor ? &y[0] : &x[0];
+    for (size_t l = 0; l < n; l++)
+    {
+        const T s = vector_detail::Mul(alpha, outer[l]);
+        T* al = &a.Line(l)[0];
+        for (size_t e = 0; e < n; e++)
+        {
+            al[e] += vector_detail::Mul(s, inner[e]);
+        }
+    }
+}
+
+
+// -------------------- Level 3 --------------------
+
+/**
+ * @brief C = alpha * A * B + beta * C.
+ *
+ * Раскладки A, B и C независимы; порядок циклов выбирается так, чтобы
+ * внутренний цикл шёл по линиям хранения подряд (см. matrix_detail::GemmLines).
+ * При beta == 0 прежнее содержимое C не читается (как в BLAS).
+ *
+ * @tparam T Тип элементов.
+ * @param alpha Множитель произведения.
+ * @param a Левая матрица; не должна совпадать с c.
+ * @param b Правая матрица; не должна совпадать с c.
+ * @param beta Множитель прежнего значения C.
+ * @param c Матрица-результат (изменяется на месте).
+ * @throws std::invalid_argument если размеры несовместимы или c совпадает с a или b.
+ */
+template<typename T, typename LA, typename LB, typename LC>
+void gemm(const T& alpha, const TDynamicMatrix<T, LA>& a, const TDynamicMatrix<T, LB>& b,
+    const T& beta, TDynamicMatrix<T, LC>& c)
+{
+    TTRACE_SCOPE("gemm", a.GetSize());
+    if (a.GetSize() != b.GetSize() || a.GetSize() != c.GetSize())
+    {
+        throw std::invalid_argument("Matrices must be of the same size for gemm");
+    }
+
+    if (static_cast<const void*>(&a) == static_cast<const void*>(&c) ||
+        static_cast<const void*>(&b) == static_cast<const void*>(&c))
+    {
+        throw std::invalid_argument("Input and output matrices of gemm must not alias");
+    }
+
+    size_t n = a.GetSize();
+    const bool zero_beta = (beta == T());
+    for (size_t l = 0; l < n; l++)
+    {
+        T* cl = &c.Line(l)[0];
+        for (size_t e = 0; e < n; e++)
+        {
+            cl[e] = zero_beta ? T() : vector_detail::Mul(beta, cl[e]);
+        }
+    }
+
+    matrix_detail::GemmLines(n, alpha, &a.Line(0), LA::IsRowMajor, &b.Line(0), LB::IsRowMajor,
+        &c.Line(0), LC::IsRowMajor);
+}
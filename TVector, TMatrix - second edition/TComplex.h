@@ -0,0 +1,85 @@
+﻿#pragma once
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "TBlas.h"
+
+// Комплексные ядра -
+// TDynamicVector/TDynamicMatrix<std::complex<T>> используют в ядрах прямую формулу
+// умножения (vector_detail::Mul); здесь - разделённое (планарное) хранение, в котором
+// действительные и мнимые части лежат в отдельных вещественных массивах и
+// обрабатываются вещественными ядрами TBlas
+
+// алгоритм комплексного умножения матриц
+enum class TComplexGemm
+{
+    Classic4M,   // 4 вещественных умножения: Re = ArBr - AiBi, Im = ArBi + AiBr
+    Gauss3M      // 3 вещественных умножения: ArBr, AiBi, (Ar + Ai)(Br + Bi)
+};
+
+// Комплексный вектор с разделённым хранением
+template<typename T>
+class TSplitComplexVector
+{
+    static_assert(std::is_floating_point<T>::value, "TSplitComplexVector requires a floating-point element type");
+public:
+    TDynamicVector<T> re;
+    TDynamicVector<T> im;
+
+    explicit TSplitComplexVector(size_t n = 1) : re(n), im(n) {}
+    explicit TSplitComplexVector(const TDynamicVector<std::complex<T>>& v);
+    TSplitComplexVector(TDynamicVector<T>&& real, TDynamicVector<T>&& imag);   // из готовых частей одного размера
+
+    size_t GetSize() const noexcept { return re.GetSize(); }
+    std::complex<T> Get(size_t i) const { return std::complex<T>(re[i], im[i]); }
+
+    // обратно в чередующееся хранение
+    TDynamicVector<std::complex<T>> ToInterleaved() const;
+};
+
+// Комплексная матрица с разделённым хранением (части - по строкам)
+template<typename T>
+class TSplitComplexMatrix
+{
+    static_assert(std::is_floating_point<T>::value, "TSplitComplexMatrix requires a floating-point element type");
+public:
+    TDynamicMatrix<T> re;
+    TDynamicMatrix<T> im;
+
+    explicit TSplitComplexMatrix(size_t n = 1) : re(n), im(n) {}
+    template<typename L>
+    explicit TSplitComplexMatrix(const TDynamicMatrix<std::complex<T>, L>& m);
+
+    size_t GetSize() const noexcept { return re.GetSize(); }
+    std::complex<T> Get(size_t i, size_t j) const { return std::complex<T>(re[i][j], im[i][j]); }
+
+    // обратно в чередующееся хранение
+    TDynamicMatrix<std::complex<T>> ToInterleaved() const;
+};
+
+// поэлементные операции
+template<typename T>
+TSplitComplexVector<T> Add(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b);                  // a + b
+template<typename T>
+TSplitComplexVector<T> MultiplyElementwise(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b);  // a[i] * b[i]
+
+// скалярные произведения
+template<typename T>
+std::complex<T> Dot(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b);    // a^T * b
+template<typename T>
+std::complex<T> Dotc(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b);   // a^H * b
+
+// умножение матрицы на вектор и на матрицу
+template<typename T>
+TSplitComplexVector<T> Multiply(const TSplitComplexMatrix<T>& a, const TSplitComplexVector<T>& x);
+template<typename T>
+TSplitComplexMatrix<T> Multiply(const TSplitComplexMatrix<T>& a, const TSplitComplexMatrix<T>& b,
+    TComplexGemm algorithm = TComplexGemm::Classic4M);
+
+// умножение матриц в чередующемся хранении с выбором алгоритма
+template<typename T, typename L>
+TDynamicMatrix<std::complex<T>, L> ComplexGemm(const TDynamicMatrix<std::complex<T>, L>& a,
+    const TDynamicMatrix<std::complex<T>, L>& b, TComplexGemm algorithm = TComplexGemm::Classic4M);
+
+#include "TComplex.tpp"
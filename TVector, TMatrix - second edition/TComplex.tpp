@@ -0,0 +1,313 @@
+﻿// -------------------- Split storage --------------------
+
+/**
+ * @brief Разделение вектора из чередующегося хранения.
+ *
+ * @tparam T Вещественный тип частей.
+ * @param v Комплексный вектор.
+ */
+template<typename T>
+TSplitComplexVector<T>::TSplitComplexVector(const TDynamicVector<std::complex<T>>& v) : re(v.GetSize()), im(v.GetSize())
+{
+    for (size_t i = 0; i < v.GetSize(); i++)
+    {
+        re[i] = v[i].real();
+        im[i] = v[i].imag();
+    }
+}
+
+/**
+ * @brief Вектор из готовых частей (без копирования).
+ *
+ * @tparam T Вещественный тип частей.
+ * @param real Действительные части.
+ * @param imag Мнимые части.
+ * @throws std::invalid_argument если размеры частей не совпадают.
+ */
+template<typename T>
+TSplitComplexVector<T>::TSplitComplexVector(TDynamicVector<T>&& real, TDynamicVector<T>&& imag) : re(std::move(real)), im(std::move(imag))
+{
+    if (re.GetSize() != im.GetSize())
+    {
+        throw std::invalid_argument("Real and imaginary parts must be of the same size");
+    }
+}
+
+/**
+ * @brief Сборка вектора в чередующееся хранение.
+ *
+ * @return Вектор std::complex<T>.
+ */
+template<typename T>
+TDynamicVector<std::complex<T>> TSplitComplexVector<T>::ToInterleaved() const
+{
+    TDynamicVector<std::complex<T>> result(GetSize());
+    for (size_t i = 0; i < GetSize(); i++)
+    {
+        result[i] = std::complex<T>(re[i], im[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Разделение матрицы из чередующегося хранения.
+ *
+ * @tparam T Вещественный тип частей.
+ * @tparam L Раскладка исходной матрицы.
+ * @param m Комплексная матрица.
+ */
+template<typename T>
+template<typename L>
+TSplitComplexMatrix<T>::TSplitComplexMatrix(const TDynamicMatrix<std::complex<T>, L>& m) : re(m.GetSize()), im(m.GetSize())
+{
+    size_t n = m.GetSize();
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            const std::complex<T> z = m[i][j];
+            re[i][j] = z.real();
+            im[i][j] = z.imag();
+        }
+    }
+}
+
+/**
+ * @brief Сборка матрицы в чередующееся хранение.
+ *
+ * @return Матрица std::complex<T> по строкам.
+ */
+template<typename T>
+TDynamicMatrix<std::complex<T>> TSplitComplexMatrix<T>::ToInterleaved() const
+{
+    size_t n = GetSize();
+    TDynamicMatrix<std::complex<T>> result(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        const T* ri = &re.Line(i)[0];
+        const T* ii = &im.Line(i)[0];
+        std::complex<T>* out = &result.Line(i)[0];
+        for (size_t j = 0; j < n; j++)
+        {
+            out[j] = std::complex<T>(ri[j], ii[j]);
+        }
+    }
+    return result;
+}
+
+
+// -------------------- Elementwise --------------------
+
+/**
+ * @brief Сложение комплексных векторов: части складываются независимо.
+ *
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return a + b.
+ */
+template<typename T>
+TSplitComplexVector<T> Add(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b)
+{
+    TTRACE_SCOPE("Add(split complex)", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for addition");
+    }
+
+    return TSplitComplexVector<T>(Add(policy::automatic, a.re, b.re), Add(policy::automatic, a.im, b.im));
+}
+
+/**
+ * @brief Поэлементное произведение комплексных векторов.
+ *
+ * Цикл над четырьмя вещественными массивами без перестановок частей,
+ * векторизуется компилятором.
+ *
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Вектор a[i] * b[i].
+ */
+template<typename T>
+TSplitComplexVector<T> MultiplyElementwise(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b)
+{
+    TTRACE_SCOPE("MultiplyElementwise(split complex)", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for multiplication");
+    }
+
+    size_t n = a.GetSize();
+    TSplitComplexVector<T> result(TDynamicVector<T>(n, vector_detail::TUninitialized{}),
+        TDynamicVector<T>(n, vector_detail::TUninitialized{}));
+    const T* ar = &a.re[0];
+    const T* ai = &a.im[0];
+    const T* br = &b.re[0];
+    const T* bi = &b.im[0];
+    T* rr = &result.re[0];
+    T* ri = &result.im[0];
+    for (size_t i = 0; i < n; i++)
+    {
+        rr[i] = ar[i] * br[i] - ai[i] * bi[i];
+        ri[i] = ar[i] * bi[i] + ai[i] * br[i];
+    }
+    return result;
+}
+
+
+// -------------------- Dot products --------------------
+
+/**
+ * @brief Скалярное произведение a^T * b через четыре вещественных dot.
+ *
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return sum(a[i] * b[i]).
+ */
+template<typename T>
+std::complex<T> Dot(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b)
+{
+    TTRACE_SCOPE("Dot(split complex)", a.GetSize());
+    return std::complex<T>(dot(a.re, b.re) - dot(a.im, b.im), dot(a.re, b.im) + dot(a.im, b.re));
+}
+
+/**
+ * @brief Сопряжённое скалярное произведение a^H * b через четыре вещественных dot.
+ *
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return sum(conj(a[i]) * b[i]).
+ */
+template<typename T>
+std::complex<T> Dotc(const TSplitComplexVector<T>& a, const TSplitComplexVector<T>& b)
+{
+    TTRACE_SCOPE("Dotc(split complex)", a.GetSize());
+    return std::complex<T>(dot(a.re, b.re) + dot(a.im, b.im), dot(a.re, b.im) - dot(a.im, b.re));
+}
+
+
+// -------------------- Products --------------------
+
+/**
+ * @brief Умножение комплексной матрицы на вектор через четыре вещественных gemv.
+ *
+ * @throws std::invalid_argument если размеры несовместимы.
+ * @return a * x.
+ */
+template<typename T>
+TSplitComplexVector<T> Multiply(const TSplitComplexMatrix<T>& a, const TSplitComplexVector<T>& x)
+{
+    TTRACE_SCOPE("Multiply(split complex, vector)", a.GetSize());
+    if (a.GetSize() != x.GetSize())
+    {
+        throw std::invalid_argument("Matrix columns must match vector size for multiplication");
+    }
+
+    TSplitComplexVector<T> y(x.GetSize());
+    gemv(T(1), a.re, x.re, T(0), y.re);
+    gemv(T(-1), a.im, x.im, T(1), y.re);
+    gemv(T(1), a.re, x.im, T(0), y.im);
+    gemv(T(1), a.im, x.re, T(1), y.im);
+    return y;
+}
+
+/**
+ * @brief Умножение комплексных матриц через вещественные gemm.
+ *
+ * Classic4M — четыре умножения: Re = ArBr - AiBi, Im = ArBi + AiBr.
+ * Gauss3M — три умножения P1 = ArBr, P2 = AiBi, P3 = (Ar + Ai)(Br + Bi):
+ * Re = P1 - P2, Im = P3 - P1 - P2. Gauss3M экономит четверть умножений
+ * ценой двух сложений матриц, одной временной матрицы и немного большей
+ * погрешности мнимой части (ошибки P1 и P2 вычитаются из P3).
+ *
+ * @tparam T Вещественный тип частей.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @param algorithm Алгоритм умножения.
+ * @throws std::invalid_argument если размеры несовместимы.
+ * @return a * b.
+ */
+template<typename T>
+TSplitComplexMatrix<T> Multiply(const TSplitComplexMatrix<T>& a, const TSplitComplexMatrix<T>& b,
+    TComplexGemm algorithm)
+{
+    TTRACE_SCOPE("Multiply(split complex)", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Matrices must be of the same size for multiplication");
+    }
+
+    size_t n = a.GetSize();
+    TSplitComplexMatrix<T> c(n);
+    if (algorithm == TComplexGemm::Classic4M)
+    {
+        gemm(T(1), a.re, b.re, T(0), c.re);
+        gemm(T(-1), a.im, b.im, T(1), c.re);
+        gemm(T(1), a.re, b.im, T(0), c.im);
+        gemm(T(1), a.im, b.re, T(1), c.im);
+        return c;
+    }
+
+    TDynamicMatrix<T> sa(a.re);
+    TDynamicMatrix<T> sb(b.re);
+    for (size_t l = 0; l < n; l++)
+    {
+        axpy(T(1), a.im.Line(l), sa.Line(l));
+        axpy(T(1), b.im.Line(l), sb.Line(l));
+    }
+
+    TDynamicMatrix<T> p2(n);
+    gemm(T(1), a.re, b.re, T(0), c.re);   // P1
+    gemm(T(1), a.im, b.im, T(0), p2);     // P2
+    gemm(T(1), sa, sb, T(0), c.im);       // P3
+    for (size_t l = 0; l < n; l++)
+    {
+        axpy(T(-1), c.re.Line(l), c.im.Line(l));
+        axpy(T(-1), p2.Line(l), c.im.Line(l));
+        axpy(T(-1), p2.Line(l), c.re.Line(l));
+    }
+    return c;
+}
+
+/**
+ * @brief Умножение комплексных матриц в чередующемся хранении.
+ *
+ * Classic4M выполняется напрямую ядром operator* (matrix_detail::GemmLines
+ * без множителя, с прямой формулой комплексного умножения); Gauss3M — через
+ * разделение на части, Multiply для разделённого хранения и обратную сборку.
+ *
+ * По умолчанию выбран Classic4M: ядро gemm с прямой формулой не требует
+ * разделения и обратной сборки матриц, а экономия умножений в Gauss3M
+ * съедается дополнительными сложениями, преобразованиями и временной матрицей.
+ *
+ * @tparam T Вещественный тип частей.
+ * @tparam L Раскладка матриц.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @param algorithm Алгоритм умножения.
+ * @throws std::invalid_argument если размеры несовместимы.
+ * @return a * b в раскладке L.
+ */
+template<typename T, typename L>
+TDynamicMatrix<std::complex<T>, L> ComplexGemm(const TDynamicMatrix<std::complex<T>, L>& a,
+    const TDynamicMatrix<std::complex<T>, L>& b, TComplexGemm algorithm)
+{
+    TTRACE_SCOPE("ComplexGemm", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Matrices must be of the same size for multiplication");
+    }
+
+    if (algorithm == TComplexGemm::Classic4M)
+    {
+        size_t n = a.GetSize();
+        TDynamicMatrix<std::complex<T>, L> c(n);
+        matrix_detail::GemmLines(n, &a.Line(0), L::IsRowMajor, &b.Line(0), L::IsRowMajor, &c.Line(0), L::IsRowMajor);
+        return c;
+    }
+
+    TDynamicMatrix<std::complex<T>> c = Multiply(TSplitComplexMatrix<T>(a), TSplitComplexMatrix<T>(b), algorithm).ToInterleaved();
+    if constexpr (L::IsRowMajor)
+    {
+        return c;
+    }
+    else
+    {
+        return TDynamicMatrix<std::complex<T>, L>(c);
+    }
+}
@@ -4,25 +4,91 @@
 //
 //
 
+#pragma once
 #include <iostream>
+#include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 #include "TVector.h"
 
 static constexpr size_t MAX_MATRIX_SIZE = 10000;
 
+// ограничение размера матрицы во время выполнения (по умолчанию MAX_MATRIX_SIZE)
+size_t GetMaxMatrixSize() noexcept;
+void SetMaxMatrixSize(size_t sz) noexcept;
+
+// Раскладка матрицы в памяти:
+// TRowMajor - массив строк, TColMajor - массив столбцов
+struct TRowMajor
+{
+	static constexpr bool IsRowMajor = true;
+};
+
+struct TColMajor
+{
+	static constexpr bool IsRowMajor = false;
+};
+
+// Строка матрицы, хранящейся по столбцам (m[i][j] при TColMajor)
+template<typename T>
+class TMatrixRowRef
+{
+	TDynamicVector<T>* cols;
+	size_t row;
+	size_t n;
+public:
+	TMatrixRowRef(TDynamicVector<T>* c, size_t i, size_t s) noexcept : cols(c), row(i), n(s) {}
+
+	T& operator[](size_t j) const noexcept { return cols[j][row]; }
+	size_t GetSize() const noexcept { return n; }
+};
+
+template<typename T>
+class TMatrixConstRowRef
+{
+	const TDynamicVector<T>* cols;
+	size_t row;
+	size_t n;
+public:
+	TMatrixConstRowRef(const TDynamicVector<T>* c, size_t i, size_t s) noexcept : cols(c), row(i), n(s) {}
+
+	const T& operator[](size_t j) const noexcept { return cols[j][row]; }
+	size_t GetSize() const noexcept { return n; }
+};
+
 // Динамическая матрица - 
 // шаблонная матрица на динамической памяти
-template<typename T>
+template<typename T, typename L = TRowMajor>
 class TDynamicMatrix : private TDynamicVector<TDynamicVector<T>>
 {
 	using TDynamicVector<TDynamicVector<T>>::pMem;
 	using TDynamicVector<TDynamicVector<T>>::size;
+	using TDynamicVector<TDynamicVector<T>>::capacity;
+
+	template<typename, typename> friend class TDynamicMatrix;
+
+	// c = a * b в существующую память c (без выделения памяти)
+	static void MultiplyInto(const TDynamicMatrix& a, const TDynamicMatrix& b, TDynamicMatrix& c);
+	// c = a * b mod m для элементов из [0, m)
+	static void MultiplyIntoMod(const TDynamicMatrix& a, const TDynamicMatrix& b, TDynamicMatrix& c, unsigned long long m);
 public:
+	using Layout = L;
 
 	// конструктор по умолчанию
 	TDynamicMatrix(size_t s = 1);
 
-	// индексация без контроля
-	using TDynamicVector<TDynamicVector<T>>::operator[];
+	// преобразование раскладки (копирование с транспонированием хранения)
+	template<typename L2>
+	explicit TDynamicMatrix(const TDynamicMatrix<T, L2>& m);
+
+	// индексация без контроля: m[i][j] - строка i, столбец j при любой раскладке
+	decltype(auto) operator[](size_t i) noexcept;
+	decltype(auto) operator[](size_t i) const noexcept;
+
+	// линия хранения: строка для TRowMajor, столбец для TColMajor
+	TDynamicVector<T>& Line(size_t l) noexcept { return pMem[l]; }
+	const TDynamicVector<T>& Line(size_t l) const noexcept { return pMem[l]; }
 
 	// получение размера
 	size_t GetSize() const noexcept { return size; }
@@ -30,6 +96,7 @@ public:
 	// сравнение
 	bool operator==(const TDynamicMatrix& m) const noexcept;
 	bool operator!=(const TDynamicMatrix& m) const noexcept;
+	bool EqualsApprox(const TDynamicMatrix& m, T tol) const noexcept;
 
 	// матрично-скалярные операции
 	TDynamicMatrix operator*(const T& val);
@@ -37,33 +104,66 @@ public:
 	// матрично-векторные операции
 	TDynamicVector<T> operator*(const TDynamicVector<T>& v);
 
-	// матрично-матричные операции
-	TDynamicMatrix operator+(const TDynamicMatrix& m);
-	TDynamicMatrix operator-(const TDynamicMatrix& m);
-	TDynamicMatrix operator*(const TDynamicMatrix& m);
+	// матрично-матричные операции (в том числе с другой раскладкой; результат - в раскладке L)
+	template<typename L2>
+	TDynamicMatrix operator+(const TDynamicMatrix<T, L2>& m);
+	template<typename L2>
+	TDynamicMatrix operator-(const TDynamicMatrix<T, L2>& m);
+	template<typename L2>
+	TDynamicMatrix operator*(const TDynamicMatrix<T, L2>& m);
+
+	// возведение в степень k (k = 0 - единичная матрица)
+	TDynamicMatrix Pow(unsigned long long k) const;
+	// возведение в степень k по модулю mod (только для целых T)
+	TDynamicMatrix Pow(unsigned long long k, T mod) const;
 
 	// swap
 	void swap(TDynamicMatrix& lhs, TDynamicMatrix& rhs) noexcept;
 
-	// ввод/вывод
-	friend std::istream& operator>>(std::istream& istr, TDynamicMatrix<T>& v)
+	// ввод/вывод (по строкам при любой раскладке)
+	friend std::istream& operator>>(std::istream& istr, TDynamicMatrix& v)
 	{
 		for (size_t i = 0; i < v.size; i++)
 		{
-			istr >> v.pMem[i];
+			if constexpr (L::IsRowMajor)
+			{
+				istr >> v.pMem[i];
+			}
+			else
+			{
+				for (size_t j = 0; j < v.size; j++)
+					istr >> v.pMem[j][i];
+			}
 			std::cout << std::endl;
 		}
 		return istr;
 	}
 
-	friend std::ostream& operator<<(std::ostream& ostr, const TDynamicMatrix<T>& v)
+	friend std::ostream& operator<<(std::ostream& ostr, const TDynamicMatrix& v)
 	{
 		for (size_t i = 0; i < v.size; i++)
 		{
-			ostr << v.pMem[i] << std::endl;
+			if constexpr (L::IsRowMajor)
+			{
+				ostr << v.pMem[i] << std::endl;
+			}
+			else
+			{
+				ostr << '(' << v.pMem[0][i];
+				for (size_t j = 1; j < v.size; j++)
+					ostr << ", " << v.pMem[j][i];
+				ostr << ')' << std::endl;
+			}
 		}
 		return ostr;
 	}
 };
 
+// умножение с воспроизводимыми суммами: результат побитово одинаков при любом числе потоков,
+// ширине SIMD и раскладке (операторы * используют его в режиме SetReproducibleReductions(true))
+template<typename T, typename L>
+TDynamicVector<T> MultiplyReproducible(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& x);
+template<typename T, typename LA, typename LB>
+TDynamicMatrix<T, LA> MultiplyReproducible(const TDynamicMatrix<T, LA>& a, const TDynamicMatrix<T, LB>& b);
+
 #include "TMatrix.tpp"
\ No newline at end of file
@@ -1,4 +1,440 @@
-﻿// Constructor --------------------------------------------------------
+﻿// Limits --------------------------------------------------------
+
+namespace matrix_detail
+{
+	inline std::atomic<size_t>& MaxMatrixSizeSetting() noexcept
+	{
+		static std::atomic<size_t> max_size{ MAX_MATRIX_SIZE };
+		return max_size;
+	}
+}
+
+/**
+ * @brief Текущее ограничение размера матрицы.
+ *
+ * @return Максимально допустимое число строк (и столбцов) матрицы.
+ */
+inline size_t GetMaxMatrixSize() noexcept
+{
+	return matrix_detail::MaxMatrixSizeSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задание ограничения размера матрицы.
+ *
+ * Действует на матрицы, создаваемые после вызова.
+ *
+ * @param sz Максимально допустимое число строк (и столбцов) матрицы.
+ */
+inline void SetMaxMatrixSize(size_t sz) noexcept
+{
+	matrix_detail::MaxMatrixSizeSetting().store(sz, std::memory_order_relaxed);
+}
+
+// Layout kernels --------------------------------------------------------
+
+namespace matrix_detail
+{
+	/**
+	 * @brief alpha * x при Scaled, иначе x без умножения.
+	 *
+	 * Произведение без множителя не умножает на T(1): для std::complex прямая
+	 * формула (1 + 0i) * x даёт NaN в частях x, содержащих бесконечность.
+	 */
+	template<bool Scaled, typename T>
+	T Scale(const T& alpha, const T& x)
+	{
+		if constexpr (Scaled)
+		{
+			return vector_detail::Mul(alpha, x);
+		}
+		else
+		{
+			return x;
+		}
+	}
+
+	/**
+	 * @brief Линии [begin, end) произведения c += alpha * x * y для матриц одной раскладки.
+	 *
+	 * Линия c[l] += сумма по k от (alpha * x[l][k]) * y[k]: для TRowMajor x = a,
+	 * y = b (строка c += a[i][k] * строка b), для TColMajor x = b, y = a (столбец
+	 * c += b[k][j] * столбец a). Линии c независимы, поэтому диапазоны можно
+	 * вычислять в разных потоках; результат побитово совпадает с GemmLines.
+	 *
+	 * @tparam Scaled Умножать ли на alpha.
+	 */
+	template<bool Scaled, typename T>
+	void GemmLineRangeImpl(size_t n, size_t begin, size_t end, const T& alpha,
+		const TDynamicVector<T>* x, const TDynamicVector<T>* y, TDynamicVector<T>* c)
+	{
+		for (size_t l = begin; l < end; l++)
+		{
+			const T* xl = &x[l][0];
+			T* cl = &c[l][0];
+			for (size_t k = 0; k < n; k++)
+			{
+				const T s = Scale<Scaled>(alpha, xl[k]);
+				const T* yk = &y[k][0];
+				for (size_t e = 0; e < n; e++)
+				{
+					cl[e] += vector_detail::Mul(s, yk[e]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Линии [begin, end) произведения c += a * b для матриц одной раскладки (см. GemmLineRangeImpl).
+	 *
+	 * @param row Раскладка всех трёх матриц.
+	 */
+	template<typename T>
+	void GemmLineRange(size_t n, size_t begin, size_t end, const TDynamicVector<T>* a,
+		const TDynamicVector<T>* b, TDynamicVector<T>* c, bool row)
+	{
+		GemmLineRangeImpl<false>(n, begin, end, T(), row ? a : b, row ? b : a, c);
+	}
+
+	/**
+	 * @brief c += alpha * a * b над линиями хранения (c += a * b при Scaled == false).
+	 *
+	 * Матрицы заданы массивами линий (строк при *Row == true, столбцов иначе).
+	 * Для каждой комбинации раскладок выбирается порядок циклов, при котором
+	 * внутренний цикл идёт по линиям подряд:
+	 * - c, a, b по строкам: i-k-j (строка c += a[i][k] * строка b);
+	 * - c, a, b по столбцам: j-k-i (столбец c += b[k][j] * столбец a);
+	 * - a по строкам, b по столбцам: c[i][j] += скалярное произведение линий;
+	 * - a по столбцам, b по строкам: сумма внешних произведений по k.
+	 * Если раскладка c отличается от раскладок и a, и b, запись в c идёт с шагом.
+	 *
+	 * @tparam Scaled Умножать ли на alpha.
+	 * @param n Размер матриц.
+	 * @param alpha Множитель произведения (не используется при Scaled == false).
+	 * @param a Линии левой матрицы.
+	 * @param a_row Раскладка a.
+	 * @param b Линии правой матрицы.
+	 * @param b_row Раскладка b.
+	 * @param c Линии матрицы-результата (не должна совпадать с a или b).
+	 * @param c_row Раскладка c.
+	 */
+	template<bool Scaled, typename T>
+	void GemmLinesImpl(size_t n, const T& alpha, const TDynamicVector<T>* a, bool a_row,
+		const TDynamicVector<T>* b, bool b_row, TDynamicVector<T>* c, bool c_row)
+	{
+		if (a_row && b_row && c_row)
+		{
+			GemmLineRangeImpl<Scaled>(n, 0, n, alpha, a, b, c);
+		}
+		else if (!a_row && !b_row && !c_row)
+		{
+			GemmLineRangeImpl<Scaled>(n, 0, n, alpha, b, a, c);
+		}
+		else if (a_row && !b_row)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				const T* ai = &a[i][0];
+				for (size_t j = 0; j < n; j++)
+				{
+					const T* bj = &b[j][0];
+					T sum = T();
+					for (size_t k = 0; k < n; k++)
+					{
+						sum += vector_detail::Mul(ai[k], bj[k]);
+					}
+					T& cij = c_row ? c[i][j] : c[j][i];
+					cij += Scale<Scaled>(alpha, sum);
+				}
+			}
+		}
+		else if (!a_row && b_row)
+		{
+			for (size_t k = 0; k < n; k++)
+			{
+				const T* ak = &a[k][0];
+				const T* bk = &b[k][0];
+				if (c_row)
+				{
+					for (size_t i = 0; i < n; i++)
+					{
+						const T s = Scale<Scaled>(alpha, ak[i]);
+						T* ci = &c[i][0];
+						for (size_t j = 0; j < n; j++)
+						{
+							ci[j] += vector_detail::Mul(s, bk[j]);
+						}
+					}
+				}
+				else
+				{
+					for (size_t j = 0; j < n; j++)
+					{
+						const T s = Scale<Scaled>(alpha, bk[j]);
+						T* cj = &c[j][0];
+						for (size_t i = 0; i < n; i++)
+						{
+							cj[i] += vector_detail::Mul(s, ak[i]);
+						}
+					}
+				}
+			}
+		}
+		else if (c_row)
+		{
+			// a и b по столбцам, c по строкам
+			for (size_t j = 0; j < n; j++)
+			{
+				const T* bj = &b[j][0];
+				for (size_t k = 0; k < n; k++)
+				{
+					const T s = Scale<Scaled>(alpha, bj[k]);
+					const T* ak = &a[k][0];
+					for (size_t i = 0; i < n; i++)
+					{
+						c[i][j] += vector_detail::Mul(s, ak[i]);
+					}
+				}
+			}
+		}
+		else
+		{
+			// a и b по строкам, c по столбцам
+			for (size_t i = 0; i < n; i++)
+			{
+				const T* ai = &a[i][0];
+				for (size_t k = 0; k < n; k++)
+				{
+					const T s = Scale<Scaled>(alpha, ai[k]);
+					const T* bk = &b[k][0];
+					for (size_t j = 0; j < n; j++)
+					{
+						c[j][i] += vector_detail::Mul(s, bk[j]);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief c += alpha * a * b над линиями хранения (см. GemmLinesImpl).
+	 */
+	template<typename T>
+	void GemmLines(size_t n, const T& alpha, const TDynamicVector<T>* a, bool a_row,
+		const TDynamicVector<T>* b, bool b_row, TDynamicVector<T>* c, bool c_row)
+	{
+		GemmLinesImpl<true>(n, alpha, a, a_row, b, b_row, c, c_row);
+	}
+
+	/**
+	 * @brief c += a * b над линиями хранения без множителя (см. GemmLinesImpl).
+	 */
+	template<typename T>
+	void GemmLines(size_t n, const TDynamicVector<T>* a, bool a_row,
+		const TDynamicVector<T>* b, bool b_row, TDynamicVector<T>* c, bool c_row)
+	{
+		GemmLinesImpl<false>(n, T(), a, a_row, b, b_row, c, c_row);
+	}
+
+	/**
+	 * @brief y += alpha * a * x над линиями хранения (y += a * x при Scaled == false).
+	 *
+	 * По строкам: y[i] += alpha * (строка i, x); по столбцам: y += (alpha * x[j]) * столбец j.
+	 *
+	 * @tparam Scaled Умножать ли на alpha.
+	 * @param n Размер.
+	 * @param alpha Множитель произведения (не используется при Scaled == false).
+	 * @param a Линии матрицы.
+	 * @param a_row Раскладка a.
+	 * @param x Входной вектор (не должен совпадать с y).
+	 * @param y Вектор-результат.
+	 */
+	template<bool Scaled, typename T>
+	void GemvLinesImpl(size_t n, const T& alpha, const TDynamicVector<T>* a, bool a_row,
+		const T* x, T* y)
+	{
+		if (a_row)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				const T* ai = &a[i][0];
+				T sum = T();
+				for (size_t j = 0; j < n; j++)
+				{
+					sum += vector_detail::Mul(ai[j], x[j]);
+				}
+				y[i] += Scale<Scaled>(alpha, sum);
+			}
+		}
+		else
+		{
+			for (size_t j = 0; j < n; j++)
+			{
+				const T s = Scale<Scaled>(alpha, x[j]);
+				const T* aj = &a[j][0];
+				for (size_t i = 0; i < n; i++)
+				{
+					y[i] += vector_detail::Mul(s, aj[i]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief y += alpha * a * x над линиями хранения (см. GemvLinesImpl).
+	 */
+	template<typename T>
+	void GemvLines(size_t n, const T& alpha, const TDynamicVector<T>* a, bool a_row,
+		const T* x, T* y)
+	{
+		GemvLinesImpl<true>(n, alpha, a, a_row, x, y);
+	}
+
+	/**
+	 * @brief y += a * x над линиями хранения без множителя (см. GemvLinesImpl).
+	 */
+	template<typename T>
+	void GemvLines(size_t n, const TDynamicVector<T>* a, bool a_row, const T* x, T* y)
+	{
+		GemvLinesImpl<false>(n, T(), a, a_row, x, y);
+	}
+
+	/**
+	 * @brief Элементы [begin, end) произведения y = a * x.
+	 *
+	 * Каждый y[i] суммируется по j в порядке возрастания, как в GemvLines без
+	 * множителя, поэтому результат побитово совпадает с ним; для TColMajor
+	 * элементы строки читаются с шагом. Диапазоны можно вычислять в разных потоках.
+	 *
+	 * @param n Размер.
+	 * @param begin Первый элемент y.
+	 * @param end Конец диапазона элементов y.
+	 * @param a Линии матрицы.
+	 * @param a_row Раскладка a.
+	 * @param x Входной вектор (не должен совпадать с y).
+	 * @param y Вектор-результат (элементы [begin, end) перезаписываются).
+	 */
+	template<typename T>
+	void GemvRowRange(size_t n, size_t begin, size_t end, const TDynamicVector<T>* a, bool a_row,
+		const T* x, T* y)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			T sum = T();
+			if (a_row)
+			{
+				const T* ai = &a[i][0];
+				for (size_t j = 0; j < n; j++)
+				{
+					sum += vector_detail::Mul(ai[j], x[j]);
+				}
+			}
+			else
+			{
+				for (size_t j = 0; j < n; j++)
+				{
+					sum += vector_detail::Mul(x[j], a[j][i]);
+				}
+			}
+			y[i] = sum;
+		}
+	}
+
+	/**
+	 * @brief y[i] = сумма a[i][k] * x[k] по фиксированному дереву (vector_detail::ReproSum).
+	 *
+	 * Строки y независимы и распределяются между потоками; порядок сложения
+	 * внутри строки одинаков при любой раскладке a. Для TColMajor элементы
+	 * строки читаются с шагом.
+	 *
+	 * @param n Размер.
+	 * @param a Линии матрицы.
+	 * @param a_row Раскладка a.
+	 * @param x Входной вектор.
+	 * @param y Вектор-результат (перезаписывается).
+	 */
+	template<typename T>
+	void ReproGemvLines(size_t n, const TDynamicVector<T>* a, bool a_row, const T* x, T* y)
+	{
+		ForChunks<policy::TReproducible>(n, CheckedMul(n, sizeof(T)), [n, a, a_row, x, y](size_t begin, size_t end, size_t)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				if (a_row)
+				{
+					const T* ai = &a[i][0];
+					y[i] = vector_detail::ReproSum<T>(n, [ai, x](size_t k) { return vector_detail::Mul(ai[k], x[k]); });
+				}
+				else
+				{
+					y[i] = vector_detail::ReproSum<T>(n, [a, i, x](size_t k) { return vector_detail::Mul(a[k][i], x[k]); });
+				}
+			}
+		});
+	}
+
+	/**
+	 * @brief c[i][j] = сумма a[i][k] * b[k][j] по фиксированному дереву.
+	 *
+	 * a задана строками, b — столбцами, так что каждое слагаемое читается
+	 * подряд; линии c распределяются между потоками.
+	 *
+	 * @param n Размер.
+	 * @param a Строки левой матрицы.
+	 * @param b Столбцы правой матрицы.
+	 * @param c Линии матрицы-результата (перезаписываются).
+	 * @param c_row Раскладка c.
+	 */
+	template<typename T>
+	void ReproGemmLines(size_t n, const TDynamicVector<T>* a, const TDynamicVector<T>* b,
+		TDynamicVector<T>* c, bool c_row)
+	{
+		ForChunks<policy::TReproducible>(n, CheckedMul(CheckedMul(n, n), sizeof(T)), [n, a, b, c, c_row](size_t begin, size_t end, size_t)
+		{
+			for (size_t l = begin; l < end; l++)
+			{
+				T* cl = &c[l][0];
+				for (size_t e = 0; e < n; e++)
+				{
+					const T* ai = &a[c_row ? l : e][0];
+					const T* bj = &b[c_row ? e : l][0];
+					cl[e] = vector_detail::ReproSum<T>(n, [ai, bj](size_t k) { return vector_detail::Mul(ai[k], bj[k]); });
+				}
+			}
+		});
+	}
+
+	static constexpr size_t TRANSPOSE_BLOCK = 32;
+
+	/**
+	 * @brief c[l][e] = op(a[l][e], bt[e][l]) - поэлементная операция с матрицей другой раскладки.
+	 *
+	 * Обход блоками TRANSPOSE_BLOCK × TRANSPOSE_BLOCK, чтобы чтение bt с шагом
+	 * оставалось в кэше.
+	 */
+	template<typename T, typename Op>
+	void CombineTransposed(size_t n, const TDynamicVector<T>* a, const TDynamicVector<T>* bt,
+		TDynamicVector<T>* c, Op op)
+	{
+		for (size_t l0 = 0; l0 < n; l0 += TRANSPOSE_BLOCK)
+		{
+			size_t l1 = std::min(n, l0 + TRANSPOSE_BLOCK);
+			for (size_t e0 = 0; e0 < n; e0 += TRANSPOSE_BLOCK)
+			{
+				size_t e1 = std::min(n, e0 + TRANSPOSE_BLOCK);
+				for (size_t l = l0; l < l1; l++)
+				{
+					for (size_t e = e0; e < e1; e++)
+					{
+						c[l][e] = op(a[l][e], bt[e][l]);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Constructor --------------------------------------------------------
 
 /**
  * @brief Конструктор квадратной матрицы размера s.
@@ -6,28 +442,137 @@
  * Создаёт матрицу размера s × s, вызывая конструктор базового вектора
  * TDynamicVector<TDynamicVector<T>> для выделения памяти под строки,
  * затем инициализирует каждую строку как TDynamicVector<T>(size).
+ * Для больших матриц строки создаются параллельно согласно GetAllocPolicy():
+ * при FirstTouch блок строк создаёт тот же постоянный рабочий поток
+ * ParallelFor, который обрабатывает его в построчных ядрах. Потоки не
+ * привязаны к ядрам, поэтому строка не обязательно окажется на NUMA-узле
+ * потока, который будет её обрабатывать.
  *
  * @tparam T Тип элементов матрицы.
  * @param s Размер (количество строк и столбцов) матрицы.
  * @throws std::out_of_range если s == 0.
- * @throws std::length_error если s > MAX_MATRIX_SIZE.
+ * @throws std::length_error если s > GetMaxMatrixSize() или s * s * sizeof(T) переполняет size_t.
  */
-template <class T>
-TDynamicMatrix<T>::TDynamicMatrix(size_t s) : TDynamicVector<TDynamicVector<T>>(s)
+template <class T, class L>
+TDynamicMatrix<T, L>::TDynamicMatrix(size_t s) : TDynamicVector<TDynamicVector<T>>(s)
 {
 	if (s == 0)
 	{
 		throw std::out_of_range("Matrix size should be greater than zero");
 	}
 
-	if (s > MAX_MATRIX_SIZE)
+	if (s > GetMaxMatrixSize())
 	{
 		throw std::length_error("Matrix size exceeds maximum allowed size");
 	}
 
-	for (size_t i = 0; i < size; i++)
+	size_t bytes = CheckedMul(CheckedMul(s, s), sizeof(T));
+	TAllocPolicy policy = GetAllocPolicy();
+
+	if (policy == TAllocPolicy::Serial || bytes < GetParallelInitThreshold())
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			pMem[i] = TDynamicVector<T>(size);
+		}
+	}
+	else if (policy == TAllocPolicy::FirstTouch)
+	{
+		ParallelFor(size, [this](size_t begin, size_t end, size_t)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				pMem[i] = TDynamicVector<T>(size);
+			}
+		});
+	}
+	else
+	{
+		size_t threads = ParallelChunks(size);
+		ParallelFor(threads, [this, threads](size_t begin, size_t end, size_t)
+		{
+			for (size_t t = begin; t < end; t++)
+			{
+				for (size_t i = t; i < size; i += threads)
+				{
+					pMem[i] = TDynamicVector<T>(size);
+				}
+			}
+		});
+	}
+}
+
+/**
+ * @brief Конструктор преобразования раскладки.
+ *
+ * Копирует матрицу m с раскладкой L2 в раскладку L. При разных раскладках
+ * хранение транспонируется блоками.
+ *
+ * @tparam T Тип элементов матрицы.
+ * @tparam L Раскладка результата.
+ * @tparam L2 Раскладка исходной матрицы.
+ * @param m Исходная матрица.
+ */
+template <class T, class L>
+template <class L2>
+TDynamicMatrix<T, L>::TDynamicMatrix(const TDynamicMatrix<T, L2>& m) : TDynamicMatrix(m.size)
+{
+	if constexpr (std::is_same<L, L2>::value)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			pMem[i] = m.pMem[i];
+		}
+	}
+	else
+	{
+		matrix_detail::CombineTransposed(size, pMem, m.pMem, pMem, [](const T&, const T& y) { return y; });
+	}
+}
+
+// Indexing -----------------------------------------------------------------
+
+/**
+ * @brief Индексация строки без контроля.
+ *
+ * Для TRowMajor возвращает ссылку на строку-вектор, для TColMajor — лёгкий
+ * объект-строку TMatrixRowRef, так что m[i][j] всегда означает элемент
+ * строки i и столбца j.
+ *
+ * @tparam T Тип элементов матрицы.
+ * @param i Номер строки.
+ * @return Строка i.
+ */
+template <class T, class L>
+decltype(auto) TDynamicMatrix<T, L>::operator[](size_t i) noexcept
+{
+	if constexpr (L::IsRowMajor)
+	{
+		return (pMem[i]);
+	}
+	else
+	{
+		return TMatrixRowRef<T>(pMem, i, size);
+	}
+}
+
+/**
+ * @brief Константная индексация строки без контроля.
+ *
+ * @tparam T Тип элементов матрицы.
+ * @param i Номер строки.
+ * @return Строка i (только для чтения).
+ */
+template <class T, class L>
+decltype(auto) TDynamicMatrix<T, L>::operator[](size_t i) const noexcept
+{
+	if constexpr (L::IsRowMajor)
+	{
+		return (pMem[i]);
+	}
+	else
 	{
-		pMem[i] = TDynamicVector<T>(size);
+		return TMatrixConstRowRef<T>(pMem, i, size);
 	}
 }
 
@@ -42,9 +587,10 @@ TDynamicMatrix<T>::TDynamicMatrix(size_t s) : TDynamicVector<TDynamicVector<T>>(
  * @param m Матрица, с которой производится сравнение.
  * @return true если размеры совпадают и все соответствующие строки равны, иначе false.
  */
-template <class T>
-bool TDynamicMatrix<T>::operator==(const TDynamicMatrix<T>& m) const noexcept
+template <class T, class L>
+bool TDynamicMatrix<T, L>::operator==(const TDynamicMatrix<T, L>& m) const noexcept
 {
+	TTRACE_SCOPE("TDynamicMatrix::operator==", size);
 	bool result = true;
 	if (size != m.size)
 	{
@@ -73,12 +619,42 @@ bool TDynamicMatrix<T>::operator==(const TDynamicMatrix<T>& m) const noexcept
  * @param m Матрица для сравнения.
  * @return true если матрицы различаются, иначе false.
  */
-template <class T>
-bool TDynamicMatrix<T>::operator!=(const TDynamicMatrix<T>& m) const noexcept
+template <class T, class L>
+bool TDynamicMatrix<T, L>::operator!=(const TDynamicMatrix<T, L>& m) const noexcept
 {
 	return !(*this == m);
 }
 
+/**
+ * @brief Сравнение с допуском.
+ *
+ * Матрицы равны, если размеры совпадают и все строки равны с точностью tol
+ * (см. TDynamicVector::EqualsApprox); сравнение прекращается на первой
+ * различающейся строке.
+ *
+ * @tparam T Вещественный тип элементов матрицы.
+ * @param m Матрица для сравнения.
+ * @param tol Допуск (>= 0).
+ * @return true если матрицы совпадают с точностью tol, иначе false.
+ */
+template <class T, class L>
+bool TDynamicMatrix<T, L>::EqualsApprox(const TDynamicMatrix<T, L>& m, T tol) const noexcept
+{
+	if (size != m.size)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		if (!pMem[i].EqualsApprox(m.pMem[i], tol))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 // Matrix-scalar multiplication -----------------------------------------------------------------
 
 /**
@@ -91,10 +667,11 @@ bool TDynamicMatrix<T>::operator!=(const TDynamicMatrix<T>& m) const noexcept
  * @param val Скаляр для умножения.
  * @return Новая матрица такого же размера, результат умножения.
  */
-template <class T>
-TDynamicMatrix<T> TDynamicMatrix<T>::operator*(const T& val)
+template <class T, class L>
+TDynamicMatrix<T, L> TDynamicMatrix<T, L>::operator*(const T& val)
 {
-	TDynamicMatrix<T> result(size);
+	TTRACE_SCOPE("TDynamicMatrix::operator*(T)", size);
+	TDynamicMatrix<T, L> result(size);
 	for (size_t i = 0; i < size; i++)
 	{
 		result.pMem[i] = pMem[i] * val;
@@ -107,25 +684,30 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator*(const T& val)
 /**
  * @brief Умножение матрицы на вектор (матрица * вектор).
  *
- * Выполняет стандартное умножение: результат[i] = dot(pMem[i], v).
+ * Выполняет стандартное умножение. Для TRowMajor результат[i] — скалярное
+ * произведение строки i и v; для TColMajor результат накапливается как сумма
+ * столбцов, умноженных на v[j], чтобы обход памяти оставался последовательным.
+ * В режиме SetReproducibleReductions(true) — MultiplyReproducible.
  *
  * @tparam T Тип элементов матрицы/вектора.
  * @param v Входной вектор; его размер должен совпадать с размером матрицы.
  * @throws std::invalid_argument если размер вектора не совпадает с размером матрицы.
  * @return Вектор-результат умножения размером size.
  */
-template <class T>
-TDynamicVector<T> TDynamicMatrix<T>::operator*(const TDynamicVector<T>& v)
+template <class T, class L>
+TDynamicVector<T> TDynamicMatrix<T, L>::operator*(const TDynamicVector<T>& v)
 {
+	TTRACE_SCOPE("TDynamicMatrix::operator*(vector)", size);
 	if (size != v.GetSize())
 	{
 		throw std::invalid_argument("Matrix columns must match vector size for multiplication");
 	}
-	TDynamicVector<T> result(size);
-	for (size_t i = 0; i < size; i++)
+	if (GetReproducibleReductions())
 	{
-		result[i] = pMem[i] * v;
+		return MultiplyReproducible(*this, v);
 	}
+	TDynamicVector<T> result(size);
+	matrix_detail::GemvLines(size, pMem, L::IsRowMajor, &v[0], &result[0]);
 	return result;
 }
 
@@ -137,15 +719,19 @@ TDynamicVector<T> TDynamicMatrix<T>::operator*(const TDynamicVector<T>& v)
  * Проверяет совместимость размеров (матрицы должны быть одинакового размера
  * и соответствующие строки должны иметь одинаковую длину) и возвращает
  * новую матрицу, в которой каждая строка — сумма соответствующих строк.
+ * Если раскладка m отличается, элементы складываются с блочным транспонированием.
  *
  * @tparam T Тип элементов матрицы.
+ * @tparam L2 Раскладка правой матрицы.
  * @param m Правая матрица для сложения.
  * @throws std::invalid_argument если размеры несовместимы.
  * @return Новая матрица — результат сложения.
  */
-template <class T>
-TDynamicMatrix<T> TDynamicMatrix<T>::operator+(const TDynamicMatrix<T>& m)
+template <class T, class L>
+template <class L2>
+TDynamicMatrix<T, L> TDynamicMatrix<T, L>::operator+(const TDynamicMatrix<T, L2>& m)
 {
+	TTRACE_SCOPE("TDynamicMatrix::operator+", size);
 	bool size_equal = true;
 
 	if (size != m.size)
@@ -169,11 +755,18 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator+(const TDynamicMatrix<T>& m)
 		throw std::invalid_argument("Matrices must be of the same size for addition");
 	}
 
-	TDynamicMatrix<T> result(size);
+	TDynamicMatrix<T, L> result(size);
 
-	for (size_t i = 0; i < size; i++)
+	if constexpr (std::is_same<L, L2>::value)
 	{
-		result.pMem[i] = pMem[i] + m.pMem[i];
+		for (size_t i = 0; i < size; i++)
+		{
+			result.pMem[i] = pMem[i] + m.pMem[i];
+		}
+	}
+	else
+	{
+		matrix_detail::CombineTransposed(size, pMem, m.pMem, result.pMem, [](const T& x, const T& y) { return x + y; });
 	}
 	return result;
 }
@@ -183,15 +776,19 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator+(const TDynamicMatrix<T>& m)
  *
  * Проверяет совместимость размеров и возвращает новую матрицу,
  * представляющую разность соответствующих строк.
+ * Если раскладка m отличается, элементы вычитаются с блочным транспонированием.
  *
  * @tparam T Тип элементов матрицы.
+ * @tparam L2 Раскладка правой матрицы.
  * @param m Правая матрица для вычитания.
  * @throws std::invalid_argument если размеры несовместимы.
  * @return Новая матрица — результат вычитания.
  */
-template <class T>
-TDynamicMatrix<T> TDynamicMatrix<T>::operator-(const TDynamicMatrix<T>& m)
+template <class T, class L>
+template <class L2>
+TDynamicMatrix<T, L> TDynamicMatrix<T, L>::operator-(const TDynamicMatrix<T, L2>& m)
 {
+	TTRACE_SCOPE("TDynamicMatrix::operator-", size);
 	bool size_equal = true;
 	if (size != m.size)
 	{
@@ -212,10 +809,17 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator-(const TDynamicMatrix<T>& m)
 	{
 		throw std::invalid_argument("Matrices must be of the same size for subtraction");
 	}
-	TDynamicMatrix<T> result(size);
-	for (size_t i = 0; i < size; i++)
+	TDynamicMatrix<T, L> result(size);
+	if constexpr (std::is_same<L, L2>::value)
 	{
-		result.pMem[i] = pMem[i] - m.pMem[i];
+		for (size_t i = 0; i < size; i++)
+		{
+			result.pMem[i] = pMem[i] - m.pMem[i];
+		}
+	}
+	else
+	{
+		matrix_detail::CombineTransposed(size, pMem, m.pMem, result.pMem, [](const T& x, const T& y) { return x - y; });
 	}
 	return result;
 }
@@ -225,16 +829,22 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator-(const TDynamicMatrix<T>& m)
  *
  * Выполняет классическое матричное умножение: result = (*this) * m.
  * Перед выполнением проверяет совместимость размеров (в данном коде —
- * квадраты одинакового размера).
+ * квадраты одинакового размера). Порядок циклов выбирается по раскладкам
+ * обоих операндов (см. matrix_detail::GemmLines); матрица другой раскладки
+ * используется как есть, без предварительного транспонирования.
+ * В режиме SetReproducibleReductions(true) — MultiplyReproducible.
  *
  * @tparam T Тип элементов матрицы.
+ * @tparam L2 Раскладка правой матрицы.
  * @param m Правая матрица для умножения.
  * @throws std::invalid_argument если размеры несовместимы.
  * @return Новая матрица — результат умножения.
  */
-template <class T>
-TDynamicMatrix<T> TDynamicMatrix<T>::operator*(const TDynamicMatrix<T>& m)
+template <class T, class L>
+template <class L2>
+TDynamicMatrix<T, L> TDynamicMatrix<T, L>::operator*(const TDynamicMatrix<T, L2>& m)
 {
+	TTRACE_SCOPE("TDynamicMatrix::operator*(matrix)", size);
 	bool size_fine = true;
 	if (size != m.size)
 	{
@@ -257,17 +867,234 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator*(const TDynamicMatrix<T>& m)
 		throw std::invalid_argument("Matrices must be of the same size (not mathematically though) for multiplication");
 	}
 
-	TDynamicMatrix<T> result(size);
+	if (GetReproducibleReductions())
+	{
+		return MultiplyReproducible(*this, m);
+	}
+	TDynamicMatrix<T, L> result(size);
+	matrix_detail::GemmLines(size, pMem, L::IsRowMajor, m.pMem, L2::IsRowMajor, result.pMem, L::IsRowMajor);
+	return result;
+}
+
+/**
+ * @brief Умножение матриц в существующую память: c = a * b.
+ *
+ * Внутренний цикл идёт по линиям хранения b и c подряд (i-k-j для TRowMajor,
+ * j-k-i для TColMajor). Каждый элемент c[i][j] накапливается по k в порядке
+ * возрастания, как в классической формуле. Память не выделяется; c не должна
+ * совпадать с a или b.
+ *
+ * @tparam T Тип элементов матрицы.
+ * @param a Левая матрица.
+ * @param b Правая матрица того же размера.
+ * @param c Матрица-результат того же размера.
+ */
+template <class T, class L>
+void TDynamicMatrix<T, L>::MultiplyInto(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b, TDynamicMatrix<T, L>& c)
+{
+	size_t n = a.size;
+	for (size_t i = 0; i < n; i++)
+	{
+		T* ci = &c.pMem[i][0];
+		for (size_t j = 0; j < n; j++)
+		{
+			ci[j] = T();
+		}
+	}
+	matrix_detail::GemmLines(n, a.pMem, L::IsRowMajor, b.pMem, L::IsRowMajor, c.pMem, L::IsRowMajor);
+}
+
+// Matrix power -----------------------------------------------------------------
 
-	for (size_t i = 0; i < size; i++)
+namespace matrix_detail
+{
+	/**
+	 * @brief (a * b) mod m без переполнения для a, b < m.
+	 *
+	 * При m <= 2^32 произведение помещается в 64 бита; иначе используется
+	 * 128-битное умножение, если оно доступно, либо сложение удвоением.
+	 */
+	inline unsigned long long MulMod(unsigned long long a, unsigned long long b, unsigned long long m) noexcept
 	{
-		for (size_t j = 0; j < size; j++)
+		if (m <= (1ULL << 32))
+		{
+			return a * b % m;
+		}
+#if defined(__SIZEOF_INT128__)
+		return static_cast<unsigned long long>(static_cast<unsigned __int128>(a) * b % m);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long long high = 0;
+		unsigned long long low = _umul128(a, b, &high);
+		unsigned long long rem = 0;
+		_udiv128(high, low, m, &rem);
+		return rem;
+#else
+		unsigned long long result = 0;
+		while (b != 0)
+		{
+			if (b & 1)
+			{
+				result = (result >= m - a) ? result - (m - a) : result + a;
+			}
+			a = (a >= m - a) ? a - (m - a) : a + a;
+			b >>= 1;
+		}
+		return result;
+#endif
+	}
+
+	/**
+	 * @brief (a + b) mod m без переполнения для a, b < m.
+	 */
+	inline unsigned long long AddMod(unsigned long long a, unsigned long long b, unsigned long long m) noexcept
+	{
+		return (a >= m - b) ? a - (m - b) : a + b;
+	}
+}
+
+/**
+ * @brief Умножение по модулю в существующую память: c = a * b mod m.
+ *
+ * Элементы a и b должны лежать в [0, m). Редукция выполняется внутри ядра
+ * после каждого умножения и сложения, поэтому промежуточные значения не
+ * переполняются при любом m, представимом в T. Для TColMajor линии хранения —
+ * строки транспонированных матриц, поэтому ядро вычисляет c^T = b^T * a^T
+ * тем же построчным обходом.
+ *
+ * @tparam T Целочисленный тип элементов.
+ * @param a Левая матрица.
+ * @param b Правая матрица того же размера.
+ * @param c Матрица-результат того же размера.
+ * @param m Модуль (> 0).
+ */
+template <class T, class L>
+void TDynamicMatrix<T, L>::MultiplyIntoMod(const TDynamicMatrix<T, L>& a, const TDynamicMatrix<T, L>& b, TDynamicMatrix<T, L>& c, unsigned long long m)
+{
+	const TDynamicMatrix<T, L>& x = L::IsRowMajor ? a : b;
+	const TDynamicMatrix<T, L>& y = L::IsRowMajor ? b : a;
+
+	size_t n = a.size;
+	for (size_t i = 0; i < n; i++)
+	{
+		const T* ai = &x.pMem[i][0];
+		T* ci = &c.pMem[i][0];
+
+		for (size_t j = 0; j < n; j++)
+		{
+			ci[j] = T();
+		}
+
+		for (size_t k = 0; k < n; k++)
 		{
-			result.pMem[i][j] = T();
-			for (size_t k = 0; k < size; k++)
+			const unsigned long long aik = static_cast<unsigned long long>(ai[k]);
+			if (aik == 0)
 			{
-				result.pMem[i][j] += pMem[i][k] * m.pMem[k][j];
+				continue;
 			}
+			const T* bk = &y.pMem[k][0];
+			for (size_t j = 0; j < n; j++)
+			{
+				unsigned long long prod = matrix_detail::MulMod(aik, static_cast<unsigned long long>(bk[j]), m);
+				ci[j] = static_cast<T>(matrix_detail::AddMod(static_cast<unsigned long long>(ci[j]), prod, m));
+			}
+		}
+	}
+}
+
+/**
+ * @brief Возведение матрицы в степень k.
+ *
+ * Двоичное возведение в степень: O(log k) умножений. Все умножения пишут в
+ * заранее выделенный буфер, который затем меняется местами (swap) с
+ * результатом или основанием, так что на шаг не выделяется память.
+ *
+ * @tparam T Тип элементов матрицы.
+ * @param k Показатель степени.
+ * @return Матрица A^k (единичная при k == 0).
+ */
+template <class T, class L>
+TDynamicMatrix<T, L> TDynamicMatrix<T, L>::Pow(unsigned long long k) const
+{
+	TTRACE_SCOPE("TDynamicMatrix::Pow", size);
+	TDynamicMatrix<T, L> result(size);
+	for (size_t i = 0; i < size; i++)
+	{
+		result.pMem[i][i] = T(1);
+	}
+
+	TDynamicMatrix<T, L> base(*this);
+	TDynamicMatrix<T, L> scratch(size);
+
+	while (k != 0)
+	{
+		if (k & 1)
+		{
+			MultiplyInto(result, base, scratch);
+			result.swap(result, scratch);
+		}
+		k >>= 1;
+		if (k != 0)
+		{
+			MultiplyInto(base, base, scratch);
+			base.swap(base, scratch);
+		}
+	}
+	return result;
+}
+
+/**
+ * @brief Возведение матрицы в степень k по модулю mod.
+ *
+ * Элементы исходной матрицы приводятся к [0, mod), далее — двоичное
+ * возведение в степень с редукцией внутри ядра умножения (MultiplyIntoMod),
+ * так что степени вида A^(10^18) mod p вычисляются за O(log k) умножений
+ * без переполнения.
+ *
+ * @tparam T Целочисленный тип элементов матрицы.
+ * @param k Показатель степени.
+ * @param mod Модуль (> 0).
+ * @throws std::invalid_argument если mod <= 0.
+ * @return Матрица A^k mod mod с элементами из [0, mod).
+ */
+template <class T, class L>
+TDynamicMatrix<T, L> TDynamicMatrix<T, L>::Pow(unsigned long long k, T mod) const
+{
+	TTRACE_SCOPE("TDynamicMatrix::Pow(mod)", size);
+	static_assert(std::is_integral<T>::value, "Modular matrix power requires an integral element type");
+
+	if (!(mod > T()))
+	{
+		throw std::invalid_argument("Modulus must be positive");
+	}
+
+	const unsigned long long m = static_cast<unsigned long long>(mod);
+
+	TDynamicMatrix<T, L> result(size);
+	TDynamicMatrix<T, L> base(size);
+	TDynamicMatrix<T, L> scratch(size);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		result.pMem[i][i] = static_cast<T>(1 % m);
+		for (size_t j = 0; j < size; j++)
+		{
+			T r = pMem[i][j] % mod;
+			base.pMem[i][j] = (r < T()) ? static_cast<T>(r + mod) : r;
+		}
+	}
+
+	while (k != 0)
+	{
+		if (k & 1)
+		{
+			MultiplyIntoMod(result, base, scratch, m);
+			result.swap(result, scratch);
+		}
+		k >>= 1;
+		if (k != 0)
+		{
+			MultiplyIntoMod(base, base, scratch, m);
+			base.swap(base, scratch);
 		}
 	}
 	return result;
@@ -278,16 +1105,110 @@ TDynamicMatrix<T> TDynamicMatrix<T>::operator*(const TDynamicMatrix<T>& m)
 /**
  * @brief Обмен (swap) содержимого двух матриц.
  *
- * Обменивает значения полей size и указателей pMem между lhs и rhs.
+ * Обменивает значения полей size, capacity и указателей pMem между lhs и rhs.
  * Помечен noexcept — не выбрасывает исключений.
  *
  * @tparam T Тип элементов матрицы.
  * @param lhs Левая матрица.
  * @param rhs Правая матрица.
  */
-template <class T>
-void TDynamicMatrix<T>::swap(TDynamicMatrix& lhs, TDynamicMatrix& rhs) noexcept
+template <class T, class L>
+void TDynamicMatrix<T, L>::swap(TDynamicMatrix& lhs, TDynamicMatrix& rhs) noexcept
 {
 	std::swap(lhs.size, rhs.size);
+	std::swap(lhs.capacity, rhs.capacity);
 	std::swap(lhs.pMem, rhs.pMem);
 }
+
+// Reproducible products -----------------------------------------------------------------
+
+/**
+ * @brief Воспроизводимое умножение матрицы на вектор.
+ *
+ * Каждый элемент результата — сумма по фиксированному дереву
+ * (vector_detail::ReproSum), поэтому результат побитово одинаков при любом
+ * числе потоков, ширине SIMD и раскладке матрицы. Строки распределяются
+ * между потоками при размере от GetAutoParallelThreshold().
+ *
+ * Цена относительно быстрого режима: для TRowMajor — сопоставима (те же
+ * скалярные произведения строк, разбитые на блоки; n = 2000 — около +3%);
+ * для TColMajor строки читаются с шагом, что заметно медленнее накопления по столбцам.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param a Матрица.
+ * @param x Вектор; его размер должен совпадать с размером матрицы.
+ * @throws std::invalid_argument если размеры несовместимы.
+ * @return Вектор a * x.
+ */
+template<typename T, typename L>
+TDynamicVector<T> MultiplyReproducible(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& x)
+{
+	TTRACE_SCOPE("MultiplyReproducible(vector)", a.GetSize());
+	if (a.GetSize() != x.GetSize())
+	{
+		throw std::invalid_argument("Matrix columns must match vector size for multiplication");
+	}
+	TDynamicVector<T> result(a.GetSize());
+	matrix_detail::ReproGemvLines(a.GetSize(), &a.Line(0), L::IsRowMajor, &x[0], &result[0]);
+	return result;
+}
+
+/**
+ * @brief Воспроизводимое умножение матриц.
+ *
+ * Каждый элемент результата — скалярное произведение строки a и столбца b,
+ * просуммированное по фиксированному дереву, поэтому результат побитово
+ * одинаков при любом числе потоков, ширине SIMD и раскладках. Операнды
+ * приводятся к виду «a по строкам, b по столбцам» (копией, если раскладка
+ * другая), линии результата распределяются между потоками.
+ *
+ * Цена относительно быстрого режима: до двух копий n × n и ядро в форме
+ * скалярных произведений вместо накопления строк, которое компилятор
+ * векторизует лучше, и без объединения умножений и сложений в FMA.
+ *
+ * @tparam T Тип элементов.
+ * @tparam LA Раскладка левой матрицы (и результата).
+ * @tparam LB Раскладка правой матрицы.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @throws std::invalid_argument если размеры несовместимы.
+ * @return Матрица a * b в раскладке LA.
+ */
+template<typename T, typename LA, typename LB>
+TDynamicMatrix<T, LA> MultiplyReproducible(const TDynamicMatrix<T, LA>& a, const TDynamicMatrix<T, LB>& b)
+{
+	TTRACE_SCOPE("MultiplyReproducible(matrix)", a.GetSize());
+	if (a.GetSize() != b.GetSize())
+	{
+		throw std::invalid_argument("Matrices must be of the same size (not mathematically though) for multiplication");
+	}
+
+	size_t n = a.GetSize();
+	TDynamicMatrix<T, TRowMajor> a_rows(1);
+	TDynamicMatrix<T, TColMajor> b_cols(1);
+	const TDynamicVector<T>* ar;
+	const TDynamicVector<T>* bc;
+	if constexpr (LA::IsRowMajor)
+	{
+		ar = &a.Line(0);
+	}
+	else
+	{
+		a_rows = TDynamicMatrix<T, TRowMajor>(a);
+		ar = &a_rows.Line(0);
+	}
+	if constexpr (!LB::IsRowMajor)
+	{
+		bc = &b.Line(0);
+	}
+	else
+	{
+		b_cols = TDynamicMatrix<T, TColMajor>(b);
+		bc = &b_cols.Line(0);
+	}
+
+	TDynamicMatrix<T, LA> result(n);
+	matrix_detail::ReproGemmLines(n, ar, bc, &result.Line(0), LA::IsRowMajor);
+	return result;
+}
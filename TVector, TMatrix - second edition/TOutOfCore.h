@@ -0,0 +1,73 @@
+﻿#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "TBlas.h"
+
+// Матрицы на диске -
+// квадратная матрица хранится в файле плитками tile x tile
+// (заголовок, затем плитки по строкам плиток, каждая плитка по строкам).
+// Крайние плитки дополняются нулями, поэтому размер не ограничен MAX_MATRIX_SIZE -
+// ограничен только размер плитки.
+template<typename T>
+class TDiskMatrix
+{
+    static_assert(std::is_trivially_copyable<T>::value, "TDiskMatrix requires a trivially copyable element type");
+
+    std::string path;
+    size_t sz;
+    size_t tile;
+    size_t tiles;
+    mutable std::fstream file;
+    mutable std::mutex mtx;
+
+    void Create();
+    std::streamoff TileOffset(size_t ti, size_t tj) const;
+public:
+    TDiskMatrix(const std::string& path, size_t n, size_t tile);   // создать файл с нулевой матрицей
+    template<typename L>
+    TDiskMatrix(const std::string& path, const TDynamicMatrix<T, L>& m, size_t tile);   // записать матрицу в файл
+    explicit TDiskMatrix(const std::string& path);                 // открыть существующий файл
+
+    TDiskMatrix(const TDiskMatrix&) = delete;
+    TDiskMatrix& operator=(const TDiskMatrix&) = delete;
+
+    size_t GetSize() const noexcept { return sz; }
+    size_t GetTileSize() const noexcept { return tile; }
+    size_t GetTileCount() const noexcept { return tiles; }   // плиток в строке
+    const std::string& GetPath() const noexcept { return path; }
+
+    // обмен плиткой (ti, tj) с матрицей tile x tile; безопасно из нескольких потоков
+    void ReadTile(size_t ti, size_t tj, TDynamicMatrix<T>& m) const;
+    void WriteTile(size_t ti, size_t tj, const TDynamicMatrix<T>& m);
+
+    // вся матрица в памяти (размер не больше MAX_MATRIX_SIZE)
+    TDynamicMatrix<T> ToMatrix() const;
+};
+
+// Параметры внешних операций
+struct TOutOfCoreOptions
+{
+    size_t memory_budget = size_t(1) << 30;   // байт на буферы плиток
+};
+
+// Операции над матрицами на диске -
+// плитки обрабатываются ядрами TBlas, чтение следующей плитки идёт параллельно
+// с вычислением над текущей (двойная буферизация)
+template<typename T>
+void OutOfCoreMultiply(const TDiskMatrix<T>& a, const TDiskMatrix<T>& b, TDiskMatrix<T>& c,
+    const TOutOfCoreOptions& options = {});                     // C = A * B
+template<typename T>
+void OutOfCoreAdd(const TDiskMatrix<T>& a, const TDiskMatrix<T>& b, TDiskMatrix<T>& c,
+    const TOutOfCoreOptions& options = {});                     // C = A + B
+template<typename T>
+void OutOfCoreGemv(const TDiskMatrix<T>& a, const TDynamicVector<T>& x, TDynamicVector<T>& y,
+    const TOutOfCoreOptions& options = {});                     // y = A * x
+
+#include "TOutOfCore.tpp"
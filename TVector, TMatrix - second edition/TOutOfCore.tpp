@@ -0,0 +1,544 @@
+﻿// -------------------- Helpers --------------------
+
+namespace ooc_detail
+{
+    // заголовок файла: сигнатура, размер, размер плитки, размер элемента
+    constexpr char MAGIC[8] = { 'T', 'D', 'M', 'A', 'T', 'R', 'X', '1' };
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 3 * sizeof(std::uint64_t);
+
+    /**
+     * @brief Конвейер с двойной буферизацией.
+     *
+     * load(step, slot) для шага step + 1 выполняется в отдельном потоке, пока
+     * compute(step, slot) обрабатывает уже загруженный шаг; буферы чередуются
+     * по slot = step % 2. Исключение из load или compute пробрасывается
+     * после завершения загрузки, которая ещё выполняется.
+     *
+     * @param steps Число шагов.
+     * @param load Загрузка данных шага в буфер slot.
+     * @param compute Обработка шага из буфера slot.
+     */
+    template<typename Load, typename Compute>
+    void Pipeline(size_t steps, Load&& load, Compute&& compute)
+    {
+        if (steps == 0)
+        {
+            return;
+        }
+
+        std::future<void> next = std::async(std::launch::async, load, size_t(0), size_t(0));
+        for (size_t s = 0; s < steps; s++)
+        {
+            next.get();
+            if (s + 1 < steps)
+            {
+                next = std::async(std::launch::async, load, s + 1, (s + 1) % 2);
+            }
+            compute(s, s % 2);
+        }
+    }
+
+    /**
+     * @brief Сколько плиток помещается в бюджет памяти.
+     *
+     * @param tile Размер плитки.
+     * @param elem Размер элемента в байтах.
+     * @param options Параметры с бюджетом.
+     * @param required Минимально необходимое число плиток.
+     * @throws std::length_error если бюджет меньше required плиток.
+     * @return Число плиток, помещающихся в бюджет.
+     */
+    inline size_t TilesInBudget(size_t tile, size_t elem, const TOutOfCoreOptions& options, size_t required)
+    {
+        size_t tile_bytes = CheckedMul(CheckedMul(tile, tile), elem);
+        size_t fit = options.memory_budget / tile_bytes;
+        if (fit < required)
+        {
+            throw std::length_error("Memory budget is too small for the tile size");
+        }
+        return fit;
+    }
+
+    /**
+     * @brief Обнуление плитки.
+     */
+    template<typename T>
+    void ZeroTile(TDynamicMatrix<T>& m) noexcept
+    {
+        size_t n = m.GetSize();
+        for (size_t l = 0; l < n; l++)
+        {
+            T* line = &m.Line(l)[0];
+            for (size_t e = 0; e < n; e++)
+            {
+                line[e] = T();
+            }
+        }
+    }
+}
+
+
+// -------------------- TDiskMatrix --------------------
+
+/**
+ * @brief Создание файла с нулевой матрицей.
+ *
+ * Файл расширяется до полного размера без записи данных (на большинстве
+ * файловых систем — разреженный файл). Файл не удаляется деструктором.
+ *
+ * @tparam T Тип элементов.
+ * @param path Путь к файлу (перезаписывается).
+ * @param n Размер матрицы.
+ * @param tile Размер плитки.
+ * @throws std::out_of_range если n или tile равны 0.
+ * @throws std::length_error если tile больше MAX_MATRIX_SIZE.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+TDiskMatrix<T>::TDiskMatrix(const std::string& path, size_t n, size_t tile)
+    : path(path), sz(n), tile(tile), tiles(0)
+{
+    if (n == 0 || tile == 0)
+    {
+        throw std::out_of_range("Disk matrix and tile sizes must be greater than zero");
+    }
+
+    if (tile > GetMaxMatrixSize())
+    {
+        throw std::length_error("Tile size exceeds the maximum allowed matrix size");
+    }
+
+    tiles = (n + tile - 1) / tile;
+    Create();
+}
+
+/**
+ * @brief Запись матрицы из памяти в новый файл.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка исходной матрицы.
+ * @param path Путь к файлу (перезаписывается).
+ * @param m Исходная матрица.
+ * @param tile Размер плитки.
+ * @throws std::out_of_range если tile равен 0.
+ * @throws std::length_error если tile больше MAX_MATRIX_SIZE.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+template<typename L>
+TDiskMatrix<T>::TDiskMatrix(const std::string& path, const TDynamicMatrix<T, L>& m, size_t tile)
+    : TDiskMatrix(path, m.GetSize(), tile)
+{
+    TDynamicMatrix<T> buf(tile);
+    for (size_t ti = 0; ti < tiles; ti++)
+    {
+        for (size_t tj = 0; tj < tiles; tj++)
+        {
+            for (size_t r = 0; r < tile; r++)
+            {
+                for (size_t c = 0; c < tile; c++)
+                {
+                    size_t i = ti * tile + r;
+                    size_t j = tj * tile + c;
+                    buf[r][c] = (i < sz && j < sz) ? m[i][j] : T();
+                }
+            }
+            WriteTile(ti, tj, buf);
+        }
+    }
+}
+
+/**
+ * @brief Открытие существующего файла матрицы.
+ *
+ * @tparam T Тип элементов.
+ * @param path Путь к файлу.
+ * @throws std::runtime_error если файл не открывается, повреждён или хранит элементы другого размера.
+ */
+template<typename T>
+TDiskMatrix<T>::TDiskMatrix(const std::string& path) : path(path), sz(0), tile(0), tiles(0)
+{
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open disk matrix file: " + path);
+    }
+
+    char magic[sizeof(ooc_detail::MAGIC)];
+    std::uint64_t fields[3];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(fields), sizeof(fields));
+    if (!file || !std::equal(magic, magic + sizeof(magic), ooc_detail::MAGIC) ||
+        fields[0] == 0 || fields[1] == 0 || fields[2] != sizeof(T))
+    {
+        throw std::runtime_error("Not a disk matrix file of this element type: " + path);
+    }
+
+    sz = static_cast<size_t>(fields[0]);
+    tile = static_cast<size_t>(fields[1]);
+    tiles = (sz + tile - 1) / tile;
+}
+
+/**
+ * @brief Запись заголовка и расширение файла до полного размера.
+ *
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+void TDiskMatrix<T>::Create()
+{
+    size_t tile_bytes = CheckedMul(CheckedMul(tile, tile), sizeof(T));
+    size_t total = ooc_detail::HEADER_SIZE + CheckedMul(CheckedMul(tiles, tiles), tile_bytes);
+
+    {
+        std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        std::uint64_t fields[3] = { sz, tile, sizeof(T) };
+        out.write(ooc_detail::MAGIC, sizeof(ooc_detail::MAGIC));
+        out.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+        if (!out)
+        {
+            throw std::runtime_error("Cannot create disk matrix file: " + path);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::resize_file(path, total, ec);
+    if (ec)
+    {
+        throw std::runtime_error("Cannot allocate disk matrix file: " + path);
+    }
+
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open disk matrix file: " + path);
+    }
+}
+
+/**
+ * @brief Смещение плитки (ti, tj) в файле.
+ */
+template<typename T>
+std::streamoff TDiskMatrix<T>::TileOffset(size_t ti, size_t tj) const
+{
+    std::uint64_t tile_bytes = std::uint64_t(tile) * tile * sizeof(T);
+    return static_cast<std::streamoff>(ooc_detail::HEADER_SIZE + (std::uint64_t(ti) * tiles + tj) * tile_bytes);
+}
+
+/**
+ * @brief Чтение плитки.
+ *
+ * @tparam T Тип элементов.
+ * @param ti Строка плиток.
+ * @param tj Столбец плиток.
+ * @param m Буфер размера tile x tile.
+ * @throws std::out_of_range если индекс плитки вне матрицы.
+ * @throws std::invalid_argument если размер буфера не равен размеру плитки.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+void TDiskMatrix<T>::ReadTile(size_t ti, size_t tj, TDynamicMatrix<T>& m) const
+{
+    if (ti >= tiles || tj >= tiles)
+    {
+        throw std::out_of_range("Tile index is out of range");
+    }
+
+    if (m.GetSize() != tile)
+    {
+        throw std::invalid_argument("Buffer size must match the tile size");
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    file.seekg(TileOffset(ti, tj));
+    for (size_t r = 0; r < tile; r++)
+    {
+        file.read(reinterpret_cast<char*>(&m.Line(r)[0]), static_cast<std::streamsize>(tile * sizeof(T)));
+    }
+    if (!file)
+    {
+        file.clear();
+        throw std::runtime_error("Cannot read tile from disk matrix file: " + path);
+    }
+}
+
+/**
+ * @brief Запись плитки.
+ *
+ * @tparam T Тип элементов.
+ * @param ti Строка плиток.
+ * @param tj Столбец плиток.
+ * @param m Плитка размера tile x tile.
+ * @throws std::out_of_range если индекс плитки вне матрицы.
+ * @throws std::invalid_argument если размер плитки не совпадает.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+void TDiskMatrix<T>::WriteTile(size_t ti, size_t tj, const TDynamicMatrix<T>& m)
+{
+    if (ti >= tiles || tj >= tiles)
+    {
+        throw std::out_of_range("Tile index is out of range");
+    }
+
+    if (m.GetSize() != tile)
+    {
+        throw std::invalid_argument("Buffer size must match the tile size");
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    file.seekp(TileOffset(ti, tj));
+    for (size_t r = 0; r < tile; r++)
+    {
+        file.write(reinterpret_cast<const char*>(&m.Line(r)[0]), static_cast<std::streamsize>(tile * sizeof(T)));
+    }
+    file.flush();
+    if (!file)
+    {
+        file.clear();
+        throw std::runtime_error("Cannot write tile to disk matrix file: " + path);
+    }
+}
+
+/**
+ * @brief Загрузка всей матрицы в память.
+ *
+ * @tparam T Тип элементов.
+ * @throws std::length_error если размер больше MAX_MATRIX_SIZE.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ * @return Матрица в памяти.
+ */
+template<typename T>
+TDynamicMatrix<T> TDiskMatrix<T>::ToMatrix() const
+{
+    TDynamicMatrix<T> result(sz);
+    TDynamicMatrix<T> buf(tile);
+    for (size_t ti = 0; ti < tiles; ti++)
+    {
+        for (size_t tj = 0; tj < tiles; tj++)
+        {
+            ReadTile(ti, tj, buf);
+            for (size_t r = 0; r < tile && ti * tile + r < sz; r++)
+            {
+                for (size_t c = 0; c < tile && tj * tile + c < sz; c++)
+                {
+                    result[ti * tile + r][tj * tile + c] = buf[r][c];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+
+// -------------------- Out-of-core operations --------------------
+
+/**
+ * @brief C = A * B для матриц на диске.
+ *
+ * Для каждой строки плиток i в памяти держится панель из w плиток C(i, j0..j0+w),
+ * по k читаются A(i, k) (один раз на панель) и B(k, j), и каждое произведение
+ * плиток накапливается через gemm(1, A, B, 1, C). Память — (w + 4) плиток:
+ * панель C плюс по два буфера A и B для двойной буферизации; w выбирается
+ * наибольшим по бюджету, что уменьшает число повторных чтений A.
+ * Например, 100000 x 100000 double с плиткой 4096 (128 МБ) при бюджете 48 ГБ
+ * держит целую строку плиток C (25 плиток) и читает A ровно один раз.
+ *
+ * @tparam T Тип элементов.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @param c Матрица-результат; не должна совпадать с a или b.
+ * @param options Бюджет памяти.
+ * @throws std::invalid_argument если размеры или плитки не совпадают либо c совпадает с a или b.
+ * @throws std::length_error если бюджет меньше 5 плиток.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+void OutOfCoreMultiply(const TDiskMatrix<T>& a, const TDiskMatrix<T>& b, TDiskMatrix<T>& c,
+    const TOutOfCoreOptions& options)
+{
+    TTRACE_SCOPE("OutOfCoreMultiply", a.GetSize());
+    if (a.GetSize() != b.GetSize() || a.GetSize() != c.GetSize() ||
+        a.GetTileSize() != b.GetTileSize() || a.GetTileSize() != c.GetTileSize())
+    {
+        throw std::invalid_argument("Disk matrices must have the same size and tile size for multiplication");
+    }
+
+    if (&a == &c || &b == &c)
+    {
+        throw std::invalid_argument("Output disk matrix must not alias an input");
+    }
+
+    const size_t tile = a.GetTileSize();
+    const size_t tiles = a.GetTileCount();
+    const size_t fit = ooc_detail::TilesInBudget(tile, sizeof(T), options, 5);
+    const size_t width = std::min(tiles, fit - 4);
+
+    std::vector<TDynamicMatrix<T>> abuf, bbuf, cbuf;
+    for (size_t s = 0; s < 2; s++)
+    {
+        abuf.emplace_back(tile);
+        bbuf.emplace_back(tile);
+    }
+    for (size_t w = 0; w < width; w++)
+    {
+        cbuf.emplace_back(tile);
+    }
+
+    for (size_t i = 0; i < tiles; i++)
+    {
+        for (size_t j0 = 0; j0 < tiles; j0 += width)
+        {
+            const size_t panel = std::min(width, tiles - j0);
+            for (size_t w = 0; w < panel; w++)
+            {
+                ooc_detail::ZeroTile(cbuf[w]);
+            }
+
+            // шаг = (k, jj); A(i, k) читается на первом шаге каждого k в буфер k % 2
+            ooc_detail::Pipeline(tiles * panel,
+                [&](size_t step, size_t slot)
+                {
+                    size_t k = step / panel;
+                    size_t jj = step % panel;
+                    if (jj == 0)
+                    {
+                        a.ReadTile(i, k, abuf[k % 2]);
+                    }
+                    b.ReadTile(k, j0 + jj, bbuf[slot]);
+                },
+                [&](size_t step, size_t slot)
+                {
+                    size_t k = step / panel;
+                    size_t jj = step % panel;
+                    gemm(T(1), abuf[k % 2], bbuf[slot], T(1), cbuf[jj]);
+                });
+
+            for (size_t w = 0; w < panel; w++)
+            {
+                c.WriteTile(i, j0 + w, cbuf[w]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief C = A + B для матриц на диске.
+ *
+ * Плитки A(i, j) и B(i, j) читаются с двойной буферизацией, сумма
+ * записывается на месте буфера A и сразу выгружается в C. Память — 4 плитки.
+ * c может совпадать с a или b: каждая плитка записывается после того, как
+ * прочитана.
+ *
+ * @tparam T Тип элементов.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @param c Матрица-результат.
+ * @param options Бюджет памяти.
+ * @throws std::invalid_argument если размеры или плитки не совпадают.
+ * @throws std::length_error если бюджет меньше 4 плиток.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+void OutOfCoreAdd(const TDiskMatrix<T>& a, const TDiskMatrix<T>& b, TDiskMatrix<T>& c,
+    const TOutOfCoreOptions& options)
+{
+    TTRACE_SCOPE("OutOfCoreAdd", a.GetSize());
+    if (a.GetSize() != b.GetSize() || a.GetSize() != c.GetSize() ||
+        a.GetTileSize() != b.GetTileSize() || a.GetTileSize() != c.GetTileSize())
+    {
+        throw std::invalid_argument("Disk matrices must have the same size and tile size for addition");
+    }
+
+    const size_t tile = a.GetTileSize();
+    const size_t tiles = a.GetTileCount();
+    ooc_detail::TilesInBudget(tile, sizeof(T), options, 4);
+
+    std::vector<TDynamicMatrix<T>> abuf, bbuf;
+    for (size_t s = 0; s < 2; s++)
+    {
+        abuf.emplace_back(tile);
+        bbuf.emplace_back(tile);
+    }
+
+    ooc_detail::Pipeline(tiles * tiles,
+        [&](size_t step, size_t slot)
+        {
+            a.ReadTile(step / tiles, step % tiles, abuf[slot]);
+            b.ReadTile(step / tiles, step % tiles, bbuf[slot]);
+        },
+        [&](size_t step, size_t slot)
+        {
+            for (size_t l = 0; l < tile; l++)
+            {
+                axpy(T(1), bbuf[slot].Line(l), abuf[slot].Line(l));
+            }
+            c.WriteTile(step / tiles, step % tiles, abuf[slot]);
+        });
+}
+
+/**
+ * @brief y = A * x для матрицы на диске и векторов в памяти.
+ *
+ * Плитки читаются по строкам плиток с двойной буферизацией, каждая
+ * добавляет свой вклад через matrix_detail::GemvLines. Память — 2 плитки
+ * и две копии векторов, дополненные нулями до кратного плитке размера.
+ *
+ * @tparam T Тип элементов.
+ * @param a Матрица на диске.
+ * @param x Входной вектор.
+ * @param y Вектор-результат; не должен совпадать с x.
+ * @param options Бюджет памяти.
+ * @throws std::invalid_argument если размеры несовместимы или x и y — один объект.
+ * @throws std::length_error если бюджет меньше 2 плиток.
+ * @throws std::runtime_error при ошибке ввода-вывода.
+ */
+template<typename T>
+void OutOfCoreGemv(const TDiskMatrix<T>& a, const TDynamicVector<T>& x, TDynamicVector<T>& y,
+    const TOutOfCoreOptions& options)
+{
+    TTRACE_SCOPE("OutOfCoreGemv", a.GetSize());
+    if (a.GetSize() != x.GetSize() || a.GetSize() != y.GetSize())
+    {
+        throw std::invalid_argument("Disk matrix size must match vector size for gemv");
+    }
+
+    if (&x == &y)
+    {
+        throw std::invalid_argument("Input and output vectors of gemv must not alias");
+    }
+
+    const size_t n = a.GetSize();
+    const size_t tile = a.GetTileSize();
+    const size_t tiles = a.GetTileCount();
+    ooc_detail::TilesInBudget(tile, sizeof(T), options, 2);
+
+    TDynamicVector<T> xs(tiles * tile);
+    TDynamicVector<T> ys(tiles * tile);
+    for (size_t i = 0; i < tiles * tile; i++)
+    {
+        xs[i] = i < n ? x[i] : T();
+        ys[i] = T();
+    }
+
+    std::vector<TDynamicMatrix<T>> abuf;
+    abuf.emplace_back(tile);
+    abuf.emplace_back(tile);
+
+    ooc_detail::Pipeline(tiles * tiles,
+        [&](size_t step, size_t slot)
+        {
+            a.ReadTile(step / tiles, step % tiles, abuf[slot]);
+        },
+        [&](size_t step, size_t slot)
+        {
+            size_t i = step / tiles;
+            size_t j = step % tiles;
+            matrix_detail::GemvLines(tile, &abuf[slot].Line(0), true, &xs[j * tile], &ys[i * tile]);
+        });
+
+    for (size_t i = 0; i < n; i++)
+    {
+        y[i] = ys[i];
+    }
+}
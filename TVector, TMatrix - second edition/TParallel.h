@@ -0,0 +1,71 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Параллельное выполнение -
+// общее разбиение работы между потоками для ядер и размещения памяти
+
+// число потоков (0 - по числу аппаратных ядер)
+size_t GetParallelThreads() noexcept;
+void SetParallelThreads(size_t threads) noexcept;
+
+// число блоков, на которые делится работа из count элементов
+size_t ParallelChunks(size_t count) noexcept;
+
+// границы блока c из chunks: [ChunkBegin(c), ChunkBegin(c + 1))
+size_t ChunkBegin(size_t count, size_t chunks, size_t c) noexcept;
+
+// выполняется ли текущий поток внутри ParallelFor
+bool InParallelRegion() noexcept;
+
+// f(begin, end, chunk) для каждого блока [0, count) на постоянных рабочих потоках
+// (блок c - всегда один и тот же поток); вложенные вызовы и вызовы, пока пул занят
+// другим потоком, выполняются последовательно в вызывающем потоке
+template<typename F>
+void ParallelFor(size_t count, F f);
+
+// Политики выполнения поэлементных операций
+namespace policy
+{
+    struct TSequenced {};             // в вызывающем потоке
+    struct TParallel {};              // блоками ParallelFor
+    struct TParallelUnsequenced {};   // блоками ParallelFor, внутри блока порядок операций не сохраняется
+    struct TAutomatic {};             // TParallel, начиная с GetAutoParallelThreshold() байт, иначе TSequenced
+    struct TReproducible {};          // как TAutomatic; суммы - по фиксированному дереву, побитово одинаковы при любом числе потоков
+
+    inline constexpr TSequenced seq{};
+    inline constexpr TParallel par{};
+    inline constexpr TParallelUnsequenced par_unseq{};
+    inline constexpr TAutomatic automatic{};
+    inline constexpr TReproducible reproducible{};
+}
+
+template<typename P>
+constexpr bool IsExecutionPolicy =
+    std::is_same<P, policy::TSequenced>::value || std::is_same<P, policy::TParallel>::value ||
+    std::is_same<P, policy::TParallelUnsequenced>::value || std::is_same<P, policy::TAutomatic>::value ||
+    std::is_same<P, policy::TReproducible>::value;
+
+// порог в байтах для policy::automatic (операторы без явной политики)
+size_t GetAutoParallelThreshold() noexcept;
+void SetAutoParallelThreshold(size_t bytes) noexcept;
+
+// воспроизводимые суммы в операторах (скалярное произведение, матрица * вектор, матрица * матрица)
+bool GetReproducibleReductions() noexcept;
+void SetReproducibleReductions(bool enabled) noexcept;
+
+// выполняется ли по политике P параллельно работа из count элементов размера elem байт
+template<typename P>
+bool RunsParallel(size_t count, size_t elem) noexcept;
+
+// f(begin, end, chunk) по политике P для count элементов размера elem байт
+template<typename P, typename F>
+void ForChunks(size_t count, size_t elem, F f);
+
+#include "TParallel.tpp"
@@ -0,0 +1,374 @@
+﻿// -------------------- Thread count --------------------
+
+namespace parallel_detail
+{
+    inline std::atomic<size_t>& ThreadsSetting() noexcept
+    {
+        static std::atomic<size_t> threads{ 0 };
+        return threads;
+    }
+
+    inline std::atomic<size_t>& AutoThresholdSetting() noexcept
+    {
+        static std::atomic<size_t> threshold{ size_t(1) << 22 };
+        return threshold;
+    }
+
+    inline std::atomic<bool>& ReproducibleSetting() noexcept
+    {
+        static std::atomic<bool> reproducible{ false };
+        return reproducible;
+    }
+
+    inline bool& InRegionFlag() noexcept
+    {
+        thread_local bool in_region = false;
+        return in_region;
+    }
+
+    // Постоянные рабочие потоки ParallelFor: поток w всегда выполняет блок w + 1,
+    // блок 0 - вызывающий поток. Потоки создаются по мере роста числа блоков и
+    // живут до завершения процесса; одновременно выполняется один ParallelFor
+    class TWorkerPool
+    {
+        std::mutex dispatch;                 // занят на время одного запуска; другие вызывающие не ждут его
+        std::mutex mtx;
+        std::condition_variable start_cv;
+        std::condition_variable done_cv;
+        std::vector<std::thread> threads;
+        std::uint64_t generation = 0;        // номер запуска
+        size_t chunks = 0;
+        size_t pending = 0;                  // блоков текущего запуска, ещё выполняемых рабочими потоками
+        void (*invoke)(void*, size_t) = nullptr;
+        void* context = nullptr;
+
+        void WorkerLoop(size_t worker, std::uint64_t seen);
+    public:
+        bool TryRun(size_t count, void (*fn)(void*, size_t), void* ctx);
+    };
+
+    inline TWorkerPool& WorkerPool()
+    {
+        static TWorkerPool* pool = new TWorkerPool();   // не разрушается: потоки не останавливаются при выходе
+        return *pool;
+    }
+}
+
+/**
+ * @brief Текущее число потоков для параллельных ядер.
+ *
+ * @return Заданное SetParallelThreads значение либо число аппаратных ядер (не меньше 1).
+ */
+inline size_t GetParallelThreads() noexcept
+{
+    size_t threads = parallel_detail::ThreadsSetting().load(std::memory_order_relaxed);
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+/**
+ * @brief Задание числа потоков для параллельных ядер.
+ *
+ * @param threads Число потоков; 0 — по числу аппаратных ядер.
+ */
+inline void SetParallelThreads(size_t threads) noexcept
+{
+    parallel_detail::ThreadsSetting().store(threads, std::memory_order_relaxed);
+}
+
+
+// -------------------- Partitioning --------------------
+
+/**
+ * @brief Число блоков для работы из count элементов.
+ *
+ * Один непрерывный блок на поток: при одинаковом count границы блоков при
+ * размещении памяти и при последующих вычислениях совпадают.
+ *
+ * @param count Количество элементов.
+ * @return Число блоков в диапазоне [1, GetParallelThreads()].
+ */
+inline size_t ParallelChunks(size_t count) noexcept
+{
+    size_t threads = GetParallelThreads();
+    if (count < threads)
+    {
+        threads = count;
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+/**
+ * @brief Начало блока c при разбиении count элементов на chunks блоков.
+ *
+ * Блоки отличаются по длине не более чем на 1. Вычисление не переполняется
+ * при любых count.
+ *
+ * @param count Количество элементов.
+ * @param chunks Количество блоков (> 0).
+ * @param c Номер блока в диапазоне [0, chunks].
+ * @return Индекс первого элемента блока (для c == chunks — count).
+ */
+inline size_t ChunkBegin(size_t count, size_t chunks, size_t c) noexcept
+{
+    size_t base = count / chunks;
+    size_t extra = count % chunks;
+    return c * base + (c < extra ? c : extra);
+}
+
+/**
+ * @brief Проверка, выполняется ли текущий поток внутри ParallelFor.
+ */
+inline bool InParallelRegion() noexcept
+{
+    return parallel_detail::InRegionFlag();
+}
+
+
+// -------------------- Worker pool --------------------
+
+/**
+ * @brief Цикл рабочего потока: ждёт очередной запуск и выполняет свой блок.
+ *
+ * @param worker Номер потока (выполняет блок worker + 1).
+ * @param seen Номер последнего запуска, известного потоку.
+ */
+inline void parallel_detail::TWorkerPool::WorkerLoop(size_t worker, std::uint64_t seen)
+{
+    std::unique_lock<std::mutex> lock(mtx);
+    for (;;)
+    {
+        start_cv.wait(lock, [this, seen]() { return generation != seen; });
+        seen = generation;
+        if (worker + 1 >= chunks)
+        {
+            continue;
+        }
+
+        void (*fn)(void*, size_t) = invoke;
+        void* ctx = context;
+        lock.unlock();
+        fn(ctx, worker + 1);
+        lock.lock();
+        if (--pending == 0)
+        {
+            done_cv.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief Выполнение fn(ctx, c) для блоков c из [0, count), если пул свободен.
+ *
+ * Блок 0 выполняется в вызывающем потоке, блок c > 0 — всегда рабочим
+ * потоком c - 1. Недостающие потоки создаются перед запуском. Если пул занят
+ * запуском из другого потока, возвращает false, ничего не выполнив, — вызывающий
+ * не ждёт освобождения пула. fn не должна выбрасывать исключений.
+ *
+ * @param count Число блоков (> 1).
+ * @param fn Функция блока.
+ * @param ctx Аргумент fn.
+ * @return true если блоки выполнены пулом, false если пул занят.
+ */
+inline bool parallel_detail::TWorkerPool::TryRun(size_t count, void (*fn)(void*, size_t), void* ctx)
+{
+    std::unique_lock<std::mutex> running(dispatch, std::try_to_lock);
+    if (!running.owns_lock())
+    {
+        return false;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (threads.size() + 1 < count)
+        {
+            threads.emplace_back(&TWorkerPool::WorkerLoop, this, threads.size(), generation);
+        }
+        chunks = count;
+        pending = count - 1;
+        invoke = fn;
+        context = ctx;
+        generation++;
+    }
+    start_cv.notify_all();
+
+    fn(ctx, 0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    done_cv.wait(lock, [this]() { return pending == 0; });
+    return true;
+}
+
+
+// -------------------- ParallelFor --------------------
+
+/**
+ * @brief Параллельный цикл по блокам.
+ *
+ * Делит [0, count) на ParallelChunks(count) непрерывных блоков и вызывает
+ * f(begin, end, chunk) для каждого: блок 0 — в вызывающем потоке, блок c —
+ * всегда в одном и том же постоянном рабочем потоке c - 1 (потоки не
+ * создаются заново при каждом вызове). Пул один на процесс: если он занят
+ * вызовом из другого потока (например, другого рабочего TThreadPoolExecutor),
+ * блоки выполняются последовательно в вызывающем потоке с теми же границами,
+ * и независимые вызывающие не ждут друг друга. Вызов изнутри другого
+ * ParallelFor выполняется последовательно одним блоком. Первое исключение из f пробрасывается после
+ * завершения всех блоков.
+ *
+ * @tparam F Тип функции f(size_t begin, size_t end, size_t chunk).
+ * @param count Количество элементов.
+ * @param f Тело цикла.
+ */
+template<typename F>
+void ParallelFor(size_t count, F f)
+{
+    size_t chunks = ParallelChunks(count);
+    if (chunks <= 1 || InParallelRegion())
+    {
+        f(size_t(0), count, size_t(0));
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex error_mtx;
+    auto run = [&](size_t c)
+    {
+        bool& in_region = parallel_detail::InRegionFlag();
+        bool saved = in_region;
+        in_region = true;
+        try
+        {
+            f(ChunkBegin(count, chunks, c), ChunkBegin(count, chunks, c + 1), c);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(error_mtx);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+        in_region = saved;
+    };
+
+    if (!parallel_detail::WorkerPool().TryRun(chunks, [](void* ctx, size_t c) { (*static_cast<decltype(run)*>(ctx))(c); }, &run))
+    {
+        for (size_t c = 0; c < chunks; c++)
+        {
+            run(c);
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+
+// -------------------- Execution policies --------------------
+
+/**
+ * @brief Порог автоматического распараллеливания (в байтах).
+ */
+inline size_t GetAutoParallelThreshold() noexcept
+{
+    return parallel_detail::AutoThresholdSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задание порога автоматического распараллеливания.
+ *
+ * Операции с policy::automatic (в том числе операторы без явной политики)
+ * выполняются параллельно, если обрабатывают не меньше bytes байт.
+ * SIZE_MAX отключает автоматическое распараллеливание.
+ *
+ * @param bytes Порог в байтах.
+ */
+inline void SetAutoParallelThreshold(size_t bytes) noexcept
+{
+    parallel_detail::AutoThresholdSetting().store(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Режим воспроизводимых сумм в операторах.
+ */
+inline bool GetReproducibleReductions() noexcept
+{
+    return parallel_detail::ReproducibleSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Включение режима воспроизводимых сумм.
+ *
+ * Когда режим включён, скалярное произведение векторов и умножение матрицы
+ * на вектор и на матрицу выполняются как с policy::reproducible: результат
+ * побитово одинаков при любом числе потоков, раскладке и ширине SIMD.
+ *
+ * @param enabled true — воспроизводимые суммы, false — быстрые.
+ */
+inline void SetReproducibleReductions(bool enabled) noexcept
+{
+    parallel_detail::ReproducibleSetting().store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Выбор параллельного исполнения по политике.
+ *
+ * TSequenced — никогда; TParallel и TParallelUnsequenced — всегда;
+ * TAutomatic и TReproducible — если count * elem не меньше GetAutoParallelThreshold().
+ *
+ * @tparam P Политика выполнения.
+ * @param count Количество элементов.
+ * @param elem Размер элемента в байтах.
+ * @return true если работу следует выполнять через ParallelFor.
+ */
+template<typename P>
+bool RunsParallel(size_t count, size_t elem) noexcept
+{
+    static_assert(IsExecutionPolicy<P>, "P must be one of the policy:: execution policies");
+
+    if constexpr (std::is_same<P, policy::TSequenced>::value)
+    {
+        return false;
+    }
+    else if constexpr (std::is_same<P, policy::TAutomatic>::value || std::is_same<P, policy::TReproducible>::value)
+    {
+        return count >= GetAutoParallelThreshold() / (elem == 0 ? 1 : elem);
+    }
+    else
+    {
+        return true;
+    }
+}
+
+/**
+ * @brief Цикл по блокам с выбором исполнения по политике.
+ *
+ * При параллельном исполнении (см. RunsParallel) — ParallelFor, иначе один
+ * вызов f(0, count, 0). Границы блоков совпадают с блоками, которыми
+ * AllocateElements обнуляет память при TAllocPolicy::FirstTouch, и блок
+ * выполняет тот же рабочий поток; потоки не привязаны к ядрам, так что
+ * размещение страниц на узле потока не гарантируется.
+ *
+ * @tparam P Политика выполнения.
+ * @tparam F Тип функции f(size_t begin, size_t end, size_t chunk).
+ * @param count Количество элементов.
+ * @param elem Размер элемента в байтах.
+ * @param f Тело цикла.
+ */
+template<typename P, typename F>
+void ForChunks(size_t count, size_t elem, F f)
+{
+    if (RunsParallel<P>(count, elem))
+    {
+        ParallelFor(count, f);
+    }
+    else
+    {
+        f(size_t(0), count, size_t(0));
+    }
+}
@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "TMatrix.h"
+
+// Полукольца -
+// "умножение" матриц с заменой (+, *) на операции полукольца S:
+// c[i][j] = Add по k от Mul(a[i][k], b[k][j]).
+// Полукольцо задаётся структурой с value_type и статическими функциями
+// Zero() (нейтральный по Add, поглощающий по Mul), One() (нейтральный по Mul),
+// Add(x, y) и Mul(x, y)
+
+// обычная арифметика (+, *) - умножение тем же ядром, что и operator*
+template<typename T>
+struct TArithmeticSemiring
+{
+    using value_type = T;
+    static T Zero() noexcept { return T(); }
+    static T One() noexcept { return T(1); }
+    static T Add(const T& x, const T& y) { return x + y; }
+    static T Mul(const T& x, const T& y) { return vector_detail::Mul(x, y); }
+};
+
+// (min, +) - кратчайшие пути; Zero - бесконечность (или максимум для целых типов).
+// Для целых типов Mul - сложение с насыщением: переполнение вверх даёт Zero(), вниз - lowest()
+template<typename T>
+struct TMinPlusSemiring
+{
+    using value_type = T;
+    static T Zero() noexcept
+    {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+    static T One() noexcept { return T(); }
+    static T Add(const T& x, const T& y) { return std::min(x, y); }
+    static T Mul(const T& x, const T& y)
+    {
+        if constexpr (std::numeric_limits<T>::has_infinity)
+        {
+            return x + y;
+        }
+        else
+        {
+            if (x == Zero() || y == Zero() || (y > T() && x > Zero() - y))
+                return Zero();
+            if constexpr (std::numeric_limits<T>::is_signed)
+            {
+                if (y < T() && x < std::numeric_limits<T>::lowest() - y)
+                    return std::numeric_limits<T>::lowest();
+            }
+            return x + y;
+        }
+    }
+};
+
+// (max, +) - самые длинные/вероятные пути (Витерби в логарифмах); Zero - минус бесконечность.
+// Для целых типов Mul - сложение с насыщением: переполнение вниз даёт Zero(), вверх - max()
+template<typename T>
+struct TMaxPlusSemiring
+{
+    using value_type = T;
+    static T Zero() noexcept
+    {
+        return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    }
+    static T One() noexcept { return T(); }
+    static T Add(const T& x, const T& y) { return std::max(x, y); }
+    static T Mul(const T& x, const T& y)
+    {
+        if constexpr (std::numeric_limits<T>::has_infinity)
+        {
+            return x + y;
+        }
+        else
+        {
+            if (x == Zero() || y == Zero())
+                return Zero();
+            if constexpr (std::numeric_limits<T>::is_signed)
+            {
+                if (y < T() && x < Zero() - y)
+                    return Zero();
+            }
+            if (y > T() && x > std::numeric_limits<T>::max() - y)
+                return std::numeric_limits<T>::max();
+            return x + y;
+        }
+    }
+};
+
+// (or, and) - достижимость; умножение упакованными в 64-битные слова строками
+struct TBooleanSemiring
+{
+    using value_type = bool;
+    static bool Zero() noexcept { return false; }
+    static bool One() noexcept { return true; }
+    static bool Add(bool x, bool y) noexcept { return x || y; }
+    static bool Mul(bool x, bool y) noexcept { return x && y; }
+};
+
+// c = a * b над полукольцом S (матрицы одной раскладки)
+template<typename S, typename L>
+TDynamicMatrix<typename S::value_type, L> SemiringMultiply(const TDynamicMatrix<typename S::value_type, L>& a,
+    const TDynamicMatrix<typename S::value_type, L>& b);
+
+// замыкание (One на диагонали Add a) в степени 2^m >= n - 1, возведением в квадрат
+// (для min-plus - кратчайшие пути между всеми парами, для boolean - транзитивное замыкание)
+template<typename S, typename L>
+TDynamicMatrix<typename S::value_type, L> SemiringClosure(const TDynamicMatrix<typename S::value_type, L>& a);
+
+#include "TSemiring.tpp"
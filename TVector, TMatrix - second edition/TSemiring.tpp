@@ -0,0 +1,247 @@
+﻿// -------------------- Kernels --------------------
+
+namespace semiring_detail
+{
+    // строк правого операнда в блоке по k: блок остаётся в кэше, пока по нему проходят строки блока потока
+    static constexpr size_t K_BLOCK = 64;
+
+    /**
+     * @brief c[i] = Add по k от Mul(x[i][k], y[k]) для матриц по строкам.
+     *
+     * Строки c делятся между потоками (ForChunks по policy::automatic),
+     * внутри блока строк k обходится блоками K_BLOCK. Слагаемые с
+     * x[i][k] == Zero() пропускаются: Zero поглощает Mul и нейтрален по Add,
+     * так что результат не меняется, а для разреженных графов (бесконечные
+     * веса) работа сокращается. При Swapped вычисляется c^T = b^T * a^T для
+     * матриц по столбцам (x = b, y = a), аргументы Mul переставляются обратно,
+     * так что коммутативность Mul не требуется.
+     *
+     * @tparam S Полукольцо.
+     * @tparam Swapped Операнды переставлены (раскладка TColMajor).
+     * @param n Размер.
+     * @param x Линии левого операнда.
+     * @param y Линии правого операнда.
+     * @param c Линии результата (перезаписываются).
+     */
+    template<typename S, bool Swapped>
+    void GenericRows(size_t n, const TDynamicVector<typename S::value_type>* x,
+        const TDynamicVector<typename S::value_type>* y, TDynamicVector<typename S::value_type>* c)
+    {
+        using T = typename S::value_type;
+        ForChunks<policy::TAutomatic>(n, CheckedMul(CheckedMul(n, n), sizeof(T)), [n, x, y, c](size_t begin, size_t end, size_t)
+        {
+            const T zero = S::Zero();
+            for (size_t i = begin; i < end; i++)
+            {
+                T* ci = &c[i][0];
+                for (size_t j = 0; j < n; j++)
+                {
+                    ci[j] = zero;
+                }
+            }
+
+            for (size_t k0 = 0; k0 < n; k0 += K_BLOCK)
+            {
+                size_t k1 = std::min(n, k0 + K_BLOCK);
+                for (size_t i = begin; i < end; i++)
+                {
+                    const T* xi = &x[i][0];
+                    T* ci = &c[i][0];
+                    for (size_t k = k0; k < k1; k++)
+                    {
+                        const T s = xi[k];
+                        if (s == zero)
+                        {
+                            continue;
+                        }
+                        const T* yk = &y[k][0];
+                        for (size_t j = 0; j < n; j++)
+                        {
+                            ci[j] = S::Add(ci[j], Swapped ? S::Mul(yk[j], s) : S::Mul(s, yk[j]));
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Булево произведение с упаковкой строк правого операнда в 64-битные слова.
+     *
+     * Строка c[i] — побитовое OR строк y[k] по всем k с x[i][k] == true,
+     * то есть 64 элемента за одну операцию. AND коммутативен, поэтому для
+     * TColMajor достаточно переставить операнды.
+     *
+     * @param n Размер.
+     * @param x Линии левого операнда.
+     * @param y Линии правого операнда.
+     * @param c Линии результата (перезаписываются).
+     */
+    inline void BooleanRows(size_t n, const TDynamicVector<bool>* x, const TDynamicVector<bool>* y, TDynamicVector<bool>* c)
+    {
+        const size_t words = (n + 63) / 64;
+        std::vector<std::uint64_t> packed(CheckedMul(n, words));
+        std::uint64_t* yp = packed.data();
+
+        ForChunks<policy::TAutomatic>(n, n, [n, words, y, yp](size_t begin, size_t end, size_t)
+        {
+            for (size_t k = begin; k < end; k++)
+            {
+                const bool* yk = &y[k][0];
+                std::uint64_t* row = yp + k * words;
+                for (size_t j = 0; j < n; j++)
+                {
+                    row[j / 64] |= std::uint64_t(yk[j]) << (j % 64);
+                }
+            }
+        });
+
+        ForChunks<policy::TAutomatic>(n, CheckedMul(n, words * sizeof(std::uint64_t)), [n, words, x, yp, c](size_t begin, size_t end, size_t)
+        {
+            std::vector<std::uint64_t> acc(words);
+            for (size_t i = begin; i < end; i++)
+            {
+                std::fill(acc.begin(), acc.end(), std::uint64_t(0));
+                const bool* xi = &x[i][0];
+                for (size_t k = 0; k < n; k++)
+                {
+                    if (!xi[k])
+                    {
+                        continue;
+                    }
+                    const std::uint64_t* row = yp + k * words;
+                    for (size_t w = 0; w < words; w++)
+                    {
+                        acc[w] |= row[w];
+                    }
+                }
+
+                bool* ci = &c[i][0];
+                for (size_t j = 0; j < n; j++)
+                {
+                    ci[j] = ((acc[j / 64] >> (j % 64)) & 1) != 0;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief c = a * b над полукольцом S для матриц одной раскладки.
+     *
+     * Встроенные полукольца выбирают своё ядро: TBooleanSemiring — упакованное
+     * BooleanRows, TArithmeticSemiring — matrix_detail::GemmLines (ядро operator*),
+     * остальные — GenericRows.
+     *
+     * @tparam S Полукольцо.
+     * @param n Размер.
+     * @param a Линии левой матрицы.
+     * @param b Линии правой матрицы.
+     * @param c Линии результата (перезаписываются, не должны совпадать с a или b).
+     * @param row Раскладка всех трёх матриц.
+     */
+    template<typename S>
+    void MultiplyLines(size_t n, const TDynamicVector<typename S::value_type>* a,
+        const TDynamicVector<typename S::value_type>* b, TDynamicVector<typename S::value_type>* c, bool row)
+    {
+        using T = typename S::value_type;
+        if constexpr (std::is_same<S, TBooleanSemiring>::value)
+        {
+            BooleanRows(n, row ? a : b, row ? b : a, c);
+        }
+        else if constexpr (std::is_same<S, TArithmeticSemiring<T>>::value)
+        {
+            for (size_t l = 0; l < n; l++)
+            {
+                T* cl = &c[l][0];
+                for (size_t e = 0; e < n; e++)
+                {
+                    cl[e] = T();
+                }
+            }
+            matrix_detail::GemmLines(n, a, row, b, row, c, row);
+        }
+        else if (row)
+        {
+            GenericRows<S, false>(n, a, b, c);
+        }
+        else
+        {
+            GenericRows<S, true>(n, b, a, c);
+        }
+    }
+}
+
+
+// -------------------- Products --------------------
+
+/**
+ * @brief Умножение матриц над полукольцом S.
+ *
+ * Пример: SemiringMultiply<TMinPlusSemiring<double>>(d, d) — кратчайшие пути
+ * не длиннее двух рёбер по матрице весов d.
+ *
+ * @tparam S Полукольцо.
+ * @tparam L Раскладка матриц.
+ * @param a Левая матрица.
+ * @param b Правая матрица.
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Матрица c[i][j] = Add по k от Mul(a[i][k], b[k][j]).
+ */
+template<typename S, typename L>
+TDynamicMatrix<typename S::value_type, L> SemiringMultiply(const TDynamicMatrix<typename S::value_type, L>& a,
+    const TDynamicMatrix<typename S::value_type, L>& b)
+{
+    TTRACE_SCOPE("SemiringMultiply", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Matrices must be of the same size for multiplication");
+    }
+
+    size_t n = a.GetSize();
+    TDynamicMatrix<typename S::value_type, L> c(n);
+    semiring_detail::MultiplyLines<S>(n, &a.Line(0), &b.Line(0), &c.Line(0), L::IsRowMajor);
+    return c;
+}
+
+/**
+ * @brief Замыкание матрицы над полукольцом S возведением в квадрат.
+ *
+ * Вычисляет D = (I + A)^(2^m), где I — One на диагонали и Zero вне её,
+ * + — Add, 2^m — наименьшая степень двойки не меньше n - 1. D[i][j] —
+ * Add по всем путям из i в j длиной не больше n - 1, то есть для min-plus —
+ * кратчайшие пути между всеми парами (при отсутствии отрицательных циклов),
+ * для boolean — рефлексивно-транзитивное замыкание, как у Флойда-Уоршелла,
+ * но за O(log n) умножений. Если очередной квадрат совпал с предыдущим,
+ * степень больше не меняется и возведение останавливается. Буфер выделяется
+ * один раз и меняется местами (swap) с результатом, как в Pow.
+ *
+ * @tparam S Полукольцо.
+ * @tparam L Раскладка матрицы.
+ * @param a Исходная матрица (например, веса рёбер, Zero — нет ребра).
+ * @return Замыкание (I + A)^(2^m).
+ */
+template<typename S, typename L>
+TDynamicMatrix<typename S::value_type, L> SemiringClosure(const TDynamicMatrix<typename S::value_type, L>& a)
+{
+    TTRACE_SCOPE("SemiringClosure", a.GetSize());
+    using T = typename S::value_type;
+    size_t n = a.GetSize();
+    TDynamicMatrix<T, L> d(a);
+    for (size_t i = 0; i < n; i++)
+    {
+        d[i][i] = S::Add(d[i][i], S::One());
+    }
+
+    TDynamicMatrix<T, L> scratch(n);
+    for (size_t reach = 1; reach < n - 1; reach *= 2)
+    {
+        semiring_detail::MultiplyLines<S>(n, &d.Line(0), &d.Line(0), &scratch.Line(0), L::IsRowMajor);
+        const bool stable = (scratch == d);
+        d.swap(d, scratch);
+        if (stable)
+        {
+            break;
+        }
+    }
+    return d;
+}
@@ -0,0 +1,99 @@
+﻿#pragma once
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include "TBlas.h"
+
+// Итерационные решатели СЛАУ A * x = b -
+// вся память выделяется заранее, итерации не выделяют память.
+//
+// Оператор A - TDynamicMatrix<T, L> или любой тип с методами
+// size_t GetSize() const и void Apply(const TDynamicVector<T>& x, TDynamicVector<T>& y) const (y = A * x).
+// Предобусловливатель M - тип с методом void Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const (z = M^-1 * r).
+
+// Критерии остановки
+template<typename T>
+struct TSolverOptions
+{
+    size_t max_iterations = 1000;
+    T rel_tol = T(1e-10);   // ||r|| <= rel_tol * ||b||
+    T abs_tol = T(0);       // ||r|| <= abs_tol
+
+    // вызывается после каждой итерации; false - остановить решение
+    std::function<bool(size_t iteration, T residual_norm)> callback;
+};
+
+// Результат решения
+template<typename T>
+struct TSolverResult
+{
+    size_t iterations = 0;
+    T residual_norm = T();
+    bool converged = false;
+};
+
+// Рабочая память решателей
+template<typename T>
+class TSolverWorkspace
+{
+public:
+    TDynamicVector<T> r, r0, p, v, s, t, y, z;
+
+    explicit TSolverWorkspace(size_t n) : r(n), r0(n), p(n), v(n), s(n), t(n), y(n), z(n) {}
+
+    size_t GetSize() const noexcept { return r.GetSize(); }
+};
+
+// Предобусловливатели
+template<typename T>
+class TIdentityPreconditioner
+{
+public:
+    void Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const;
+};
+
+template<typename T>
+class TJacobiPreconditioner
+{
+    TDynamicVector<T> inv_diag;
+public:
+    template<typename L>
+    explicit TJacobiPreconditioner(const TDynamicMatrix<T, L>& a);
+    explicit TJacobiPreconditioner(const TDynamicVector<T>& diag);
+
+    void Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const;
+};
+
+// неполное LU-разложение без заполнения (ILU(0)): L и U сохраняют портрет ненулевых элементов A
+template<typename T>
+class TILU0Preconditioner
+{
+    TDynamicMatrix<T> lu;
+public:
+    template<typename L>
+    explicit TILU0Preconditioner(const TDynamicMatrix<T, L>& a);
+
+    void Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const;
+};
+
+// метод сопряжённых градиентов (A симметричная положительно определённая)
+template<typename T, typename Op, typename Prec = TIdentityPreconditioner<T>>
+TSolverResult<T> ConjugateGradient(const Op& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options = {}, const Prec& m = Prec());
+
+// стабилизированный метод бисопряжённых градиентов (A общего вида)
+template<typename T, typename Op, typename Prec = TIdentityPreconditioner<T>>
+TSolverResult<T> BiCGSTAB(const Op& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options = {}, const Prec& m = Prec());
+
+// метод Якоби (A с диагональным преобладанием)
+template<typename T, typename L>
+TSolverResult<T> Jacobi(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options = {});
+
+// метод Гаусса-Зейделя (A с диагональным преобладанием или SPD)
+template<typename T, typename L>
+TSolverResult<T> GaussSeidel(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options = {});
+
+#include "TSolvers.tpp"
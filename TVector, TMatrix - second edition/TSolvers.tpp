@@ -0,0 +1,554 @@
+﻿// -------------------- Helpers --------------------
+
+namespace solver_detail
+{
+    /**
+     * @brief y = A * x для матрицы.
+     */
+    template<typename T, typename L>
+    void ApplyOperator(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& x, TDynamicVector<T>& y)
+    {
+        gemv(T(1), a, x, T(0), y);
+    }
+
+    /**
+     * @brief y = A * x для пользовательского оператора.
+     */
+    template<typename T, typename Op>
+    void ApplyOperator(const Op& a, const TDynamicVector<T>& x, TDynamicVector<T>& y)
+    {
+        a.Apply(x, y);
+    }
+
+    /**
+     * @brief Проверка размеров системы и рабочей памяти.
+     *
+     * @throws std::invalid_argument если размеры A, b, x и рабочей памяти не совпадают.
+     */
+    template<typename T>
+    void CheckSizes(size_t n, const TDynamicVector<T>& b, const TDynamicVector<T>& x, const TSolverWorkspace<T>& ws)
+    {
+        if (b.GetSize() != n || x.GetSize() != n || ws.GetSize() != n)
+        {
+            throw std::invalid_argument("Operator, right-hand side, solution and workspace sizes must match");
+        }
+    }
+
+    /**
+     * @brief dst = src поэлементно (без выделения памяти).
+     */
+    template<typename T>
+    void Assign(TDynamicVector<T>& dst, const TDynamicVector<T>& src) noexcept
+    {
+        size_t n = src.GetSize();
+        for (size_t i = 0; i < n; i++)
+        {
+            dst[i] = src[i];
+        }
+    }
+
+    /**
+     * @brief r = b - r (r содержит A * x).
+     */
+    template<typename T>
+    void ResidualFromProduct(const TDynamicVector<T>& b, TDynamicVector<T>& r) noexcept
+    {
+        size_t n = b.GetSize();
+        for (size_t i = 0; i < n; i++)
+        {
+            r[i] = b[i] - r[i];
+        }
+    }
+
+    /**
+     * @brief Евклидова норма вектора.
+     */
+    template<typename T>
+    T Norm(const TDynamicVector<T>& v)
+    {
+        using std::sqrt;
+        return sqrt(dot(v, v));
+    }
+
+    /**
+     * @brief Порог сходимости max(abs_tol, rel_tol * ||b||).
+     */
+    template<typename T>
+    T Tolerance(const TSolverOptions<T>& options, const TDynamicVector<T>& b)
+    {
+        T rel = options.rel_tol * Norm(b);
+        return rel > options.abs_tol ? rel : options.abs_tol;
+    }
+
+    /**
+     * @brief Учёт итерации: сохраняет норму невязки и вызывает callback.
+     *
+     * @return true если решение следует продолжать.
+     */
+    template<typename T>
+    bool Report(TSolverResult<T>& result, size_t iteration, T residual, T tol, const TSolverOptions<T>& options)
+    {
+        result.iterations = iteration;
+        result.residual_norm = residual;
+        result.converged = residual <= tol;
+
+        if (options.callback && !options.callback(iteration, residual))
+        {
+            return false;
+        }
+        return !result.converged;
+    }
+}
+
+
+// -------------------- Preconditioners --------------------
+
+/**
+ * @brief Тождественный предобусловливатель: z = r.
+ */
+template<typename T>
+void TIdentityPreconditioner<T>::Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const
+{
+    solver_detail::Assign(z, r);
+}
+
+/**
+ * @brief Предобусловливатель Якоби по диагонали матрицы.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param a Матрица системы.
+ * @throws std::invalid_argument если на диагонали есть нули.
+ */
+template<typename T>
+template<typename L>
+TJacobiPreconditioner<T>::TJacobiPreconditioner(const TDynamicMatrix<T, L>& a) : inv_diag(a.GetSize())
+{
+    for (size_t i = 0; i < a.GetSize(); i++)
+    {
+        if (a[i][i] == T())
+        {
+            throw std::invalid_argument("Jacobi preconditioner requires a nonzero diagonal");
+        }
+        inv_diag[i] = T(1) / a[i][i];
+    }
+}
+
+/**
+ * @brief Предобусловливатель Якоби по заданной диагонали (для пользовательских операторов).
+ *
+ * @tparam T Тип элементов.
+ * @param diag Диагональ оператора.
+ * @throws std::invalid_argument если на диагонали есть нули.
+ */
+template<typename T>
+TJacobiPreconditioner<T>::TJacobiPreconditioner(const TDynamicVector<T>& diag) : inv_diag(diag.GetSize())
+{
+    for (size_t i = 0; i < diag.GetSize(); i++)
+    {
+        if (diag[i] == T())
+        {
+            throw std::invalid_argument("Jacobi preconditioner requires a nonzero diagonal");
+        }
+        inv_diag[i] = T(1) / diag[i];
+    }
+}
+
+/**
+ * @brief z = D^-1 * r.
+ */
+template<typename T>
+void TJacobiPreconditioner<T>::Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const
+{
+    size_t n = r.GetSize();
+    for (size_t i = 0; i < n; i++)
+    {
+        z[i] = inv_diag[i] * r[i];
+    }
+}
+
+/**
+ * @brief Построение ILU(0).
+ *
+ * Исключение Гаусса в порядке i-k-j, в котором обновляются только позиции,
+ * ненулевые в исходной матрице; L (с единичной диагональю) и U хранятся в
+ * одной построчной матрице.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param a Матрица системы.
+ * @throws std::invalid_argument если встретился нулевой ведущий элемент.
+ */
+template<typename T>
+template<typename L>
+TILU0Preconditioner<T>::TILU0Preconditioner(const TDynamicMatrix<T, L>& a) : lu(a)
+{
+    size_t n = lu.GetSize();
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t k = 0; k < i; k++)
+        {
+            if (a[i][k] == T())
+            {
+                continue;
+            }
+            lu[i][k] /= lu[k][k];
+            const T lik = lu[i][k];
+            for (size_t j = k + 1; j < n; j++)
+            {
+                if (a[i][j] != T())
+                {
+                    lu[i][j] -= lik * lu[k][j];
+                }
+            }
+        }
+
+        if (lu[i][i] == T())
+        {
+            throw std::invalid_argument("ILU(0) encountered a zero pivot");
+        }
+    }
+}
+
+/**
+ * @brief z = (LU)^-1 * r прямой и обратной подстановкой.
+ */
+template<typename T>
+void TILU0Preconditioner<T>::Apply(const TDynamicVector<T>& r, TDynamicVector<T>& z) const
+{
+    size_t n = r.GetSize();
+    for (size_t i = 0; i < n; i++)
+    {
+        const TDynamicVector<T>& row = lu[i];
+        T sum = r[i];
+        for (size_t k = 0; k < i; k++)
+        {
+            sum -= row[k] * z[k];
+        }
+        z[i] = sum;
+    }
+
+    for (size_t i = n; i-- > 0;)
+    {
+        const TDynamicVector<T>& row = lu[i];
+        T sum = z[i];
+        for (size_t j = i + 1; j < n; j++)
+        {
+            sum -= row[j] * z[j];
+        }
+        z[i] = sum / row[i];
+    }
+}
+
+
+// -------------------- Krylov solvers --------------------
+
+/**
+ * @brief Метод сопряжённых градиентов с предобусловливанием.
+ *
+ * x используется как начальное приближение и содержит ответ. Каждая итерация —
+ * одно умножение на A, одно применение M и операции уровня 1 над рабочей
+ * памятью ws; память не выделяется.
+ *
+ * @tparam T Тип элементов.
+ * @tparam Op Тип оператора (TDynamicMatrix или тип с Apply/GetSize).
+ * @tparam Prec Тип предобусловливателя.
+ * @param a Оператор системы (симметричный положительно определённый).
+ * @param b Правая часть.
+ * @param x Начальное приближение и решение.
+ * @param ws Рабочая память того же размера.
+ * @param options Критерии остановки и callback.
+ * @param m Предобусловливатель.
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Число итераций, норма невязки и признак сходимости.
+ */
+template<typename T, typename Op, typename Prec>
+TSolverResult<T> ConjugateGradient(const Op& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options, const Prec& m)
+{
+    TTRACE_SCOPE("ConjugateGradient", b.GetSize());
+    solver_detail::CheckSizes(a.GetSize(), b, x, ws);
+
+    TSolverResult<T> result;
+    const T tol = solver_detail::Tolerance(options, b);
+
+    solver_detail::ApplyOperator(a, x, ws.r);
+    solver_detail::ResidualFromProduct(b, ws.r);
+    result.residual_norm = solver_detail::Norm(ws.r);
+    result.converged = result.residual_norm <= tol;
+    if (result.converged)
+    {
+        return result;
+    }
+
+    m.Apply(ws.r, ws.z);
+    solver_detail::Assign(ws.p, ws.z);
+    T rz = dot(ws.r, ws.z);
+
+    for (size_t it = 1; it <= options.max_iterations; it++)
+    {
+        solver_detail::ApplyOperator(a, ws.p, ws.v);
+        const T alpha = rz / dot(ws.p, ws.v);
+        axpy(alpha, ws.p, x);
+        axpy(-alpha, ws.v, ws.r);
+
+        if (!solver_detail::Report(result, it, solver_detail::Norm(ws.r), tol, options))
+        {
+            break;
+        }
+
+        m.Apply(ws.r, ws.z);
+        const T rz_new = dot(ws.r, ws.z);
+        const T beta = rz_new / rz;
+        rz = rz_new;
+
+        // p = z + beta * p
+        scal(beta, ws.p);
+        axpy(T(1), ws.z, ws.p);
+    }
+    return result;
+}
+
+/**
+ * @brief Стабилизированный метод бисопряжённых градиентов (BiCGSTAB) с правым предобусловливанием.
+ *
+ * Каждая итерация — два умножения на A и два применения M; память не
+ * выделяется. При обращении в ноль (rho == 0) решение прекращается без сходимости.
+ *
+ * @tparam T Тип элементов.
+ * @tparam Op Тип оператора (TDynamicMatrix или тип с Apply/GetSize).
+ * @tparam Prec Тип предобусловливателя.
+ * @param a Оператор системы.
+ * @param b Правая часть.
+ * @param x Начальное приближение и решение.
+ * @param ws Рабочая память того же размера.
+ * @param options Критерии остановки и callback.
+ * @param m Предобусловливатель.
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Число итераций, норма невязки и признак сходимости.
+ */
+template<typename T, typename Op, typename Prec>
+TSolverResult<T> BiCGSTAB(const Op& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options, const Prec& m)
+{
+    TTRACE_SCOPE("BiCGSTAB", b.GetSize());
+    solver_detail::CheckSizes(a.GetSize(), b, x, ws);
+
+    TSolverResult<T> result;
+    const T tol = solver_detail::Tolerance(options, b);
+    const size_t n = b.GetSize();
+
+    solver_detail::ApplyOperator(a, x, ws.r);
+    solver_detail::ResidualFromProduct(b, ws.r);
+    result.residual_norm = solver_detail::Norm(ws.r);
+    result.converged = result.residual_norm <= tol;
+    if (result.converged)
+    {
+        return result;
+    }
+
+    solver_detail::Assign(ws.r0, ws.r);
+    for (size_t i = 0; i < n; i++)
+    {
+        ws.p[i] = T();
+        ws.v[i] = T();
+    }
+    T rho = T(1);
+    T alpha = T(1);
+    T omega = T(1);
+
+    for (size_t it = 1; it <= options.max_iterations; it++)
+    {
+        const T rho_new = dot(ws.r0, ws.r);
+        if (rho_new == T())
+        {
+            break;
+        }
+        const T beta = (rho_new / rho) * (alpha / omega);
+        rho = rho_new;
+
+        // p = r + beta * (p - omega * v)
+        for (size_t i = 0; i < n; i++)
+        {
+            ws.p[i] = ws.r[i] + beta * (ws.p[i] - omega * ws.v[i]);
+        }
+
+        m.Apply(ws.p, ws.y);
+        solver_detail::ApplyOperator(a, ws.y, ws.v);
+        alpha = rho / dot(ws.r0, ws.v);
+
+        // s = r - alpha * v
+        for (size_t i = 0; i < n; i++)
+        {
+            ws.s[i] = ws.r[i] - alpha * ws.v[i];
+        }
+
+        const T s_norm = solver_detail::Norm(ws.s);
+        if (s_norm <= tol)
+        {
+            axpy(alpha, ws.y, x);
+            solver_detail::Assign(ws.r, ws.s);
+            solver_detail::Report(result, it, s_norm, tol, options);
+            break;
+        }
+
+        m.Apply(ws.s, ws.z);
+        solver_detail::ApplyOperator(a, ws.z, ws.t);
+        const T tt = dot(ws.t, ws.t);
+        omega = (tt == T()) ? T() : dot(ws.t, ws.s) / tt;
+
+        axpy(alpha, ws.y, x);
+        axpy(omega, ws.z, x);
+
+        // r = s - omega * t
+        for (size_t i = 0; i < n; i++)
+        {
+            ws.r[i] = ws.s[i] - omega * ws.t[i];
+        }
+
+        if (!solver_detail::Report(result, it, solver_detail::Norm(ws.r), tol, options) || omega == T())
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+
+// -------------------- Stationary solvers --------------------
+
+/**
+ * @brief Метод Якоби.
+ *
+ * Итерация x[i] += r[i] / a[i][i] использует невязку r = b - A * x
+ * предыдущего приближения, так что на итерацию приходится одно умножение
+ * на A. Память не выделяется.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param a Матрица системы (с ненулевой диагональю).
+ * @param b Правая часть.
+ * @param x Начальное приближение и решение.
+ * @param ws Рабочая память того же размера.
+ * @param options Критерии остановки и callback.
+ * @throws std::invalid_argument если размеры не совпадают или на диагонали есть нули.
+ * @return Число итераций, норма невязки и признак сходимости.
+ */
+template<typename T, typename L>
+TSolverResult<T> Jacobi(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options)
+{
+    TTRACE_SCOPE("Jacobi", b.GetSize());
+    solver_detail::CheckSizes(a.GetSize(), b, x, ws);
+
+    const size_t n = b.GetSize();
+    for (size_t i = 0; i < n; i++)
+    {
+        if (a[i][i] == T())
+        {
+            throw std::invalid_argument("Jacobi method requires a nonzero diagonal");
+        }
+        ws.z[i] = T(1) / a[i][i];
+    }
+
+    TSolverResult<T> result;
+    const T tol = solver_detail::Tolerance(options, b);
+
+    solver_detail::ApplyOperator(a, x, ws.r);
+    solver_detail::ResidualFromProduct(b, ws.r);
+    result.residual_norm = solver_detail::Norm(ws.r);
+    result.converged = result.residual_norm <= tol;
+    if (result.converged)
+    {
+        return result;
+    }
+
+    for (size_t it = 1; it <= options.max_iterations; it++)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] += ws.z[i] * ws.r[i];
+        }
+
+        solver_detail::ApplyOperator(a, x, ws.r);
+        solver_detail::ResidualFromProduct(b, ws.r);
+
+        if (!solver_detail::Report(result, it, solver_detail::Norm(ws.r), tol, options))
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Метод Гаусса-Зейделя.
+ *
+ * Прямой проход по строкам с немедленным использованием обновлённых
+ * компонент x; после прохода вычисляется невязка для проверки сходимости.
+ * Память не выделяется.
+ *
+ * @tparam T Тип элементов.
+ * @tparam L Раскладка матрицы.
+ * @param a Матрица системы (с ненулевой диагональю).
+ * @param b Правая часть.
+ * @param x Начальное приближение и решение.
+ * @param ws Рабочая память того же размера.
+ * @param options Критерии остановки и callback.
+ * @throws std::invalid_argument если размеры не совпадают или на диагонали есть нули.
+ * @return Число итераций, норма невязки и признак сходимости.
+ */
+template<typename T, typename L>
+TSolverResult<T> GaussSeidel(const TDynamicMatrix<T, L>& a, const TDynamicVector<T>& b, TDynamicVector<T>& x,
+    TSolverWorkspace<T>& ws, const TSolverOptions<T>& options)
+{
+    TTRACE_SCOPE("GaussSeidel", b.GetSize());
+    solver_detail::CheckSizes(a.GetSize(), b, x, ws);
+
+    const size_t n = b.GetSize();
+    for (size_t i = 0; i < n; i++)
+    {
+        if (a[i][i] == T())
+        {
+            throw std::invalid_argument("Gauss-Seidel method requires a nonzero diagonal");
+        }
+    }
+
+    TSolverResult<T> result;
+    const T tol = solver_detail::Tolerance(options, b);
+
+    solver_detail::ApplyOperator(a, x, ws.r);
+    solver_detail::ResidualFromProduct(b, ws.r);
+    result.residual_norm = solver_detail::Norm(ws.r);
+    result.converged = result.residual_norm <= tol;
+    if (result.converged)
+    {
+        return result;
+    }
+
+    for (size_t it = 1; it <= options.max_iterations; it++)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            auto&& row = a[i];
+            T sum = b[i];
+            for (size_t j = 0; j < n; j++)
+            {
+                if (j != i)
+                {
+                    sum -= row[j] * x[j];
+                }
+            }
+            x[i] = sum / row[i];
+        }
+
+        solver_detail::ApplyOperator(a, x, ws.r);
+        solver_detail::ResidualFromProduct(b, ws.r);
+
+        if (!solver_detail::Report(result, it, solver_detail::Norm(ws.r), tol, options))
+        {
+            break;
+        }
+    }
+    return result;
+}
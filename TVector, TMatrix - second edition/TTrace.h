@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Трассировка операций -
+// публичные операторы и ядра оборачиваются в TTRACE_SCOPE(имя, размер). Без макроса
+// TVECTOR_ENABLE_TRACING (по умолчанию не задан; задаётся в определениях препроцессора
+// проекта, например /DTVECTOR_ENABLE_TRACING) TTRACE_SCOPE раскрывается в ничто; с ним запись включается
+// во время выполнения SetTracingEnabled(true), а выключенная стоит одну атомарную загрузку.
+// Каждый поток пишет в свой буфер без блокировок: события для Chrome trace и
+// гистограммы задержек по (операция, класс размера)
+
+// число интервалов гистограммы задержек: интервал b - [2^(b-1), 2^b) нс
+static constexpr size_t TRACE_LATENCY_BUCKETS = 48;
+
+// включение записи во время выполнения (по умолчанию выключена)
+bool GetTracingEnabled() noexcept;
+void SetTracingEnabled(bool enabled) noexcept;
+
+// глубина вложенности записываемых операций (по умолчанию 1 - только внешний вызов,
+// без строк матрицы и вызываемых ядер; 0 - без ограничения)
+size_t GetTraceMaxDepth() noexcept;
+void SetTraceMaxDepth(size_t depth) noexcept;
+
+// сброс записанных событий и гистограмм (вызывать, когда трассируемые операции не выполняются)
+void ClearTrace() noexcept;
+
+// класс размера n: 0 для n == 0, иначе k для n из [2^(k-1), 2^k)
+unsigned TraceSizeClass(size_t n) noexcept;
+
+// Статистика операции в классе размера (объединённая по потокам)
+struct TTraceStats
+{
+    std::string name;
+    unsigned size_class = 0;
+    std::uint64_t count = 0;
+    std::uint64_t total_ns = 0;
+    std::uint64_t max_ns = 0;
+    std::array<std::uint64_t, TRACE_LATENCY_BUCKETS> latency{};
+
+    // верхняя граница задержки квантиля q из [0, 1] по гистограмме, нс
+    std::uint64_t Percentile(double q) const noexcept;
+};
+
+// статистика по всем операциям (упорядочена по имени и классу размера)
+std::vector<TTraceStats> GetTraceStats();
+
+// событий, не поместившихся в буферы потоков (гистограммы их учитывают)
+std::uint64_t GetTraceDroppedEvents();
+
+// экспорт: Chrome trace-event JSON (chrome://tracing, Perfetto) и текстовая сводка
+void WriteChromeTrace(std::ostream& os);
+void WriteTraceSummary(std::ostream& os);
+
+// Замер области видимости: от конструктора до деструктора.
+// name - строка со статическим временем жизни (литерал)
+class TTraceScope
+{
+    const char* name;
+    size_t n;
+    std::uint64_t start;
+    bool active;   // запись была включена при входе (глубина увеличена)
+    bool record;   // глубина не больше GetTraceMaxDepth()
+public:
+    TTraceScope(const char* name, size_t n) noexcept;
+    ~TTraceScope();
+
+    TTraceScope(const TTraceScope&) = delete;
+    TTraceScope& operator=(const TTraceScope&) = delete;
+};
+
+#define TTRACE_CONCAT_IMPL(a, b) a##b
+#define TTRACE_CONCAT(a, b) TTRACE_CONCAT_IMPL(a, b)
+
+#ifdef TVECTOR_ENABLE_TRACING
+#define TTRACE_SCOPE(name, n) TTraceScope TTRACE_CONCAT(ttrace_scope_, __LINE__)((name), static_cast<size_t>(n))
+#else
+#define TTRACE_SCOPE(name, n) ((void)0)
+#endif
+
+#include "TTrace.tpp"
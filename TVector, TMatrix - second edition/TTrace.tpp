@@ -0,0 +1,542 @@
+﻿// -------------------- Thread buffers --------------------
+
+namespace trace_detail
+{
+    // событий в буфере потока; дальше события отбрасываются (гистограммы продолжают считать)
+    static constexpr size_t EVENT_CAPACITY = size_t(1) << 15;
+    // ячеек гистограмм в буфере потока (пар операция / класс размера)
+    static constexpr size_t HISTOGRAM_SLOTS = 512;
+
+    struct TEvent
+    {
+        const char* name;
+        size_t n;
+        std::uint64_t start_ns;
+        std::uint64_t dur_ns;
+    };
+
+    // Гистограмма одной пары (операция, класс размера).
+    // Пишет только поток-владелец (load + store без RMW), читают экспортёры
+    struct THistogram
+    {
+        std::atomic<const char*> name{ nullptr };   // публикуется после size_class
+        unsigned size_class = 0;
+        std::atomic<std::uint64_t> count{ 0 };
+        std::atomic<std::uint64_t> total_ns{ 0 };
+        std::atomic<std::uint64_t> max_ns{ 0 };
+        std::array<std::atomic<std::uint64_t>, TRACE_LATENCY_BUCKETS> latency{};
+    };
+
+    // Буфер потока: в каждый момент им владеет не больше одного потока
+    struct TBuffer
+    {
+        size_t lane;
+        std::unique_ptr<TEvent[]> events;
+        std::atomic<size_t> event_count{ 0 };
+        std::atomic<std::uint64_t> dropped{ 0 };
+        std::unique_ptr<THistogram[]> histograms;
+
+        explicit TBuffer(size_t l)
+            : lane(l), events(new TEvent[EVENT_CAPACITY]), histograms(new THistogram[HISTOGRAM_SLOTS]) {}
+    };
+
+    // Реестр буферов. Буфер завершившегося потока возвращается в список свободных
+    // и достаётся следующему новому потоку (рабочие потоки ParallelFor постоянны, но
+    // потоки пользователя и TThreadPoolExecutor могут создаваться и завершаться),
+    // так что число буферов ограничено числом одновременно работающих потоков.
+    // Блокировка берётся только при первой записи потока, при его завершении и при экспорте
+    struct TRegistry
+    {
+        std::mutex mtx;
+        std::vector<std::unique_ptr<TBuffer>> buffers;
+        std::vector<TBuffer*> free;
+    };
+
+    // реестр не разрушается: потоки статических пулов могут завершаться после статических объектов
+    inline TRegistry& Registry()
+    {
+        static TRegistry* registry = new TRegistry();
+        return *registry;
+    }
+
+    inline std::atomic<bool>& EnabledSetting() noexcept
+    {
+        static std::atomic<bool> enabled{ false };
+        return enabled;
+    }
+
+    inline std::atomic<size_t>& MaxDepthSetting() noexcept
+    {
+        static std::atomic<size_t> depth{ 1 };
+        return depth;
+    }
+
+    // глубина вложенности TTraceScope в текущем потоке
+    inline size_t& Depth() noexcept
+    {
+        thread_local size_t depth = 0;
+        return depth;
+    }
+
+    // наносекунды от первого обращения (общее начало отсчёта для всех потоков)
+    inline std::uint64_t NowNs() noexcept
+    {
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    inline unsigned BitWidth(std::uint64_t x) noexcept
+    {
+        unsigned width = 0;
+        while (x != 0)
+        {
+            width++;
+            x >>= 1;
+        }
+        return width;
+    }
+
+    struct TThreadHandle
+    {
+        TBuffer* buffer = nullptr;
+
+        ~TThreadHandle()
+        {
+            if (buffer != nullptr)
+            {
+                TRegistry& registry = Registry();
+                std::lock_guard<std::mutex> lock(registry.mtx);
+                registry.free.push_back(buffer);
+            }
+        }
+    };
+
+    inline TBuffer& ThreadBuffer()
+    {
+        thread_local TThreadHandle handle;
+        if (handle.buffer == nullptr)
+        {
+            TRegistry& registry = Registry();
+            std::lock_guard<std::mutex> lock(registry.mtx);
+            if (!registry.free.empty())
+            {
+                handle.buffer = registry.free.back();
+                registry.free.pop_back();
+            }
+            else
+            {
+                registry.buffers.push_back(std::make_unique<TBuffer>(registry.buffers.size()));
+                handle.buffer = registry.buffers.back().get();
+            }
+        }
+        return *handle.buffer;
+    }
+
+    // прибавление владельцем без RMW: читатели видят атомарные значения
+    inline void Bump(std::atomic<std::uint64_t>& x, std::uint64_t d) noexcept
+    {
+        x.store(x.load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Ячейка гистограммы (name, size_class) в буфере потока.
+     *
+     * Открытая адресация по указателю на имя и классу размера; свободная ячейка
+     * занимается владельцем, имя публикуется последним (release).
+     *
+     * @return Ячейка либо nullptr, если таблица заполнена.
+     */
+    inline THistogram* FindHistogram(TBuffer& buffer, const char* name, unsigned size_class) noexcept
+    {
+        std::uint64_t key = reinterpret_cast<std::uintptr_t>(name) ^ (std::uint64_t(size_class) * 0x9E3779B97F4A7C15ULL);
+        size_t start = static_cast<size_t>((key ^ (key >> 29)) % HISTOGRAM_SLOTS);
+        for (size_t probe = 0; probe < HISTOGRAM_SLOTS; probe++)
+        {
+            THistogram& h = buffer.histograms[(start + probe) % HISTOGRAM_SLOTS];
+            const char* slot_name = h.name.load(std::memory_order_relaxed);
+            if (slot_name == nullptr)
+            {
+                h.size_class = size_class;
+                h.name.store(name, std::memory_order_release);
+                return &h;
+            }
+            if (slot_name == name && h.size_class == size_class)
+            {
+                return &h;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Запись завершённой операции в буфер текущего потока.
+     *
+     * Ошибки выделения буфера не выходят наружу: операция не записывается.
+     */
+    inline void Record(const char* name, size_t n, std::uint64_t start_ns, std::uint64_t dur_ns) noexcept
+    {
+        TBuffer* buffer = nullptr;
+        try
+        {
+            buffer = &ThreadBuffer();
+        }
+        catch (...)
+        {
+            return;
+        }
+
+        size_t index = buffer->event_count.load(std::memory_order_relaxed);
+        if (index < EVENT_CAPACITY)
+        {
+            buffer->events[index] = TEvent{ name, n, start_ns, dur_ns };
+            buffer->event_count.store(index + 1, std::memory_order_release);
+        }
+        else
+        {
+            Bump(buffer->dropped, 1);
+        }
+
+        THistogram* h = FindHistogram(*buffer, name, TraceSizeClass(n));
+        if (h == nullptr)
+        {
+            return;
+        }
+        unsigned bucket = BitWidth(dur_ns);
+        if (bucket >= TRACE_LATENCY_BUCKETS)
+        {
+            bucket = TRACE_LATENCY_BUCKETS - 1;
+        }
+        Bump(h->count, 1);
+        Bump(h->total_ns, dur_ns);
+        Bump(h->latency[bucket], 1);
+        if (dur_ns > h->max_ns.load(std::memory_order_relaxed))
+        {
+            h->max_ns.store(dur_ns, std::memory_order_relaxed);
+        }
+    }
+
+    // JSON-строка с экранированием кавычек, обратной косой черты и управляющих символов
+    inline void WriteJsonString(std::ostream& os, const char* s)
+    {
+        static const char* hex = "0123456789abcdef";
+        os << '"';
+        for (; *s != '\0'; s++)
+        {
+            unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\')
+            {
+                os << '\\' << *s;
+            }
+            else if (c < 0x20)
+            {
+                os << "\\u00" << hex[c >> 4] << hex[c & 15];
+            }
+            else
+            {
+                os << *s;
+            }
+        }
+        os << '"';
+    }
+}
+
+
+// -------------------- Settings --------------------
+
+/**
+ * @brief Включена ли запись трассировки.
+ */
+inline bool GetTracingEnabled() noexcept
+{
+    return trace_detail::EnabledSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Включение и выключение записи трассировки во время выполнения.
+ *
+ * Действует только на код, собранный с TVECTOR_ENABLE_TRACING.
+ *
+ * @param enabled Записывать ли операции.
+ */
+inline void SetTracingEnabled(bool enabled) noexcept
+{
+    trace_detail::NowNs();   // начало отсчёта - не позже первой записи
+    trace_detail::EnabledSetting().store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Глубина вложенности записываемых операций.
+ */
+inline size_t GetTraceMaxDepth() noexcept
+{
+    return trace_detail::MaxDepthSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задание глубины вложенности записываемых операций.
+ *
+ * Операторы матриц вызывают операторы векторов для строк, а операторы —
+ * ядра; при глубине 1 записывается только внешний вызов, при 2 — ещё и
+ * вызываемые им операции и т.д.
+ *
+ * @param depth Максимальная глубина; 0 — без ограничения.
+ */
+inline void SetTraceMaxDepth(size_t depth) noexcept
+{
+    trace_detail::MaxDepthSetting().store(depth, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Сброс событий и гистограмм всех буферов.
+ *
+ * Буферы остаются за потоками. Не синхронизирован с записью: вызывать, когда
+ * трассируемые операции не выполняются.
+ */
+inline void ClearTrace() noexcept
+{
+    trace_detail::TRegistry& registry = trace_detail::Registry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    for (auto& buffer : registry.buffers)
+    {
+        buffer->event_count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        for (size_t s = 0; s < trace_detail::HISTOGRAM_SLOTS; s++)
+        {
+            trace_detail::THistogram& h = buffer->histograms[s];
+            h.name.store(nullptr, std::memory_order_relaxed);
+            h.count.store(0, std::memory_order_relaxed);
+            h.total_ns.store(0, std::memory_order_relaxed);
+            h.max_ns.store(0, std::memory_order_relaxed);
+            for (auto& bucket : h.latency)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Класс размера: число значащих битов n.
+ *
+ * @param n Размер операции (элементов вектора или порядок матрицы).
+ * @return 0 для n == 0, иначе k, при котором 2^(k-1) <= n < 2^k.
+ */
+inline unsigned TraceSizeClass(size_t n) noexcept
+{
+    return trace_detail::BitWidth(n);
+}
+
+
+// -------------------- Scoped timer --------------------
+
+/**
+ * @brief Начало замера, если запись включена и глубина вложенности допустима.
+ *
+ * При выключенной записи — одна атомарная загрузка.
+ *
+ * @param name Имя операции (строка со статическим временем жизни).
+ * @param n Размер операции.
+ */
+inline TTraceScope::TTraceScope(const char* name, size_t n) noexcept
+    : name(name), n(n), start(0), active(GetTracingEnabled()), record(false)
+{
+    if (active)
+    {
+        size_t depth = ++trace_detail::Depth();
+        size_t max_depth = GetTraceMaxDepth();
+        record = (max_depth == 0 || depth <= max_depth);
+        if (record)
+        {
+            start = trace_detail::NowNs();
+        }
+    }
+}
+
+/**
+ * @brief Конец замера: событие и гистограмма в буфере текущего потока.
+ */
+inline TTraceScope::~TTraceScope()
+{
+    if (active)
+    {
+        if (record)
+        {
+            trace_detail::Record(name, n, start, trace_detail::NowNs() - start);
+        }
+        --trace_detail::Depth();
+    }
+}
+
+
+// -------------------- Export --------------------
+
+/**
+ * @brief Верхняя граница задержки квантиля q.
+ *
+ * @param q Квантиль из [0, 1] (0.5 - медиана, 0.99 - 99-й процентиль).
+ * @return Правая граница интервала гистограммы, содержащего квантиль
+ *         (не больше max_ns), нс; 0 для пустой статистики.
+ */
+inline std::uint64_t TTraceStats::Percentile(double q) const noexcept
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    double target = q * double(count);
+    std::uint64_t seen = 0;
+    for (size_t b = 0; b < TRACE_LATENCY_BUCKETS; b++)
+    {
+        seen += latency[b];
+        if (seen > 0 && double(seen) >= target)
+        {
+            std::uint64_t upper = (b == 0) ? 0 : (std::uint64_t(1) << b) - 1;
+            return upper < max_ns ? upper : max_ns;
+        }
+    }
+    return max_ns;
+}
+
+/**
+ * @brief Статистика операций, объединённая по буферам всех потоков.
+ *
+ * Ячейки с одинаковым именем (по содержимому строки) и классом размера
+ * складываются.
+ *
+ * @return Статистика, упорядоченная по имени и классу размера.
+ */
+inline std::vector<TTraceStats> GetTraceStats()
+{
+    std::map<std::pair<std::string, unsigned>, TTraceStats> merged;
+    {
+        trace_detail::TRegistry& registry = trace_detail::Registry();
+        std::lock_guard<std::mutex> lock(registry.mtx);
+        for (auto& buffer : registry.buffers)
+        {
+            for (size_t s = 0; s < trace_detail::HISTOGRAM_SLOTS; s++)
+            {
+                const trace_detail::THistogram& h = buffer->histograms[s];
+                const char* name = h.name.load(std::memory_order_acquire);
+                if (name == nullptr)
+                {
+                    continue;
+                }
+                TTraceStats& stats = merged[{ name, h.size_class }];
+                stats.name = name;
+                stats.size_class = h.size_class;
+                stats.count += h.count.load(std::memory_order_relaxed);
+                stats.total_ns += h.total_ns.load(std::memory_order_relaxed);
+                std::uint64_t max_ns = h.max_ns.load(std::memory_order_relaxed);
+                stats.max_ns = max_ns > stats.max_ns ? max_ns : stats.max_ns;
+                for (size_t b = 0; b < TRACE_LATENCY_BUCKETS; b++)
+                {
+                    stats.latency[b] += h.latency[b].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    std::vector<TTraceStats> result;
+    result.reserve(merged.size());
+    for (auto& entry : merged)
+    {
+        result.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+/**
+ * @brief Число событий, отброшенных из-за заполненных буферов потоков.
+ */
+inline std::uint64_t GetTraceDroppedEvents()
+{
+    trace_detail::TRegistry& registry = trace_detail::Registry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    std::uint64_t dropped = 0;
+    for (auto& buffer : registry.buffers)
+    {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+/**
+ * @brief Экспорт событий в формате Chrome trace-event (JSON).
+ *
+ * Каждая операция — событие "ph": "X" с началом и длительностью в
+ * микросекундах и размером в args.n; tid — номер буфера (буфер
+ * завершившегося потока переходит к следующему, поэтому tid — «дорожка»,
+ * а не идентификатор ОС). Файл открывается в chrome://tracing и Perfetto.
+ * Можно вызывать во время записи: экспортируются события, опубликованные
+ * к моменту чтения.
+ *
+ * @param os Поток вывода.
+ */
+inline void WriteChromeTrace(std::ostream& os)
+{
+    trace_detail::TRegistry& registry = trace_detail::Registry();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto& buffer : registry.buffers)
+    {
+        size_t count = buffer->event_count.load(std::memory_order_acquire);
+        for (size_t e = 0; e < count; e++)
+        {
+            const trace_detail::TEvent& ev = buffer->events[e];
+            os << (first ? "\n" : ",\n") << "{\"name\":";
+            trace_detail::WriteJsonString(os, ev.name);
+            os << ",\"cat\":\"tvector\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->lane
+               << ",\"ts\":" << ev.start_ns / 1000 << '.' << char('0' + ev.start_ns / 100 % 10)
+               << char('0' + ev.start_ns / 10 % 10) << char('0' + ev.start_ns % 10)
+               << ",\"dur\":" << ev.dur_ns / 1000 << '.' << char('0' + ev.dur_ns / 100 % 10)
+               << char('0' + ev.dur_ns / 10 % 10) << char('0' + ev.dur_ns % 10)
+               << ",\"args\":{\"n\":" << ev.n << "}}";
+            first = false;
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+/**
+ * @brief Текстовая сводка: по строке на операцию и класс размера.
+ *
+ * Столбцы: имя, диапазон размеров, число вызовов, суммарное и среднее время,
+ * p50 / p99 (верхние границы интервалов гистограммы) и максимум, в микросекундах.
+ *
+ * @param os Поток вывода.
+ */
+inline void WriteTraceSummary(std::ostream& os)
+{
+    std::vector<TTraceStats> stats = GetTraceStats();
+    os << "operation | size | count | total us | mean us | p50 us | p99 us | max us\n";
+    for (const TTraceStats& s : stats)
+    {
+        os << s.name << " | ";
+        if (s.size_class == 0)
+        {
+            os << "0";
+        }
+        else if (s.size_class < 64)
+        {
+            os << '[' << (std::uint64_t(1) << (s.size_class - 1)) << ", " << (std::uint64_t(1) << s.size_class) << ')';
+        }
+        else
+        {
+            os << ">= " << (std::uint64_t(1) << 63);
+        }
+        os << " | " << s.count
+           << " | " << double(s.total_ns) / 1000.0
+           << " | " << double(s.total_ns) / 1000.0 / double(s.count)
+           << " | " << double(s.Percentile(0.5)) / 1000.0
+           << " | " << double(s.Percentile(0.99)) / 1000.0
+           << " | " << double(s.max_ns) / 1000.0 << '\n';
+    }
+    std::uint64_t dropped = GetTraceDroppedEvents();
+    if (dropped != 0)
+    {
+        os << "dropped events (buffers full): " << dropped << '\n';
+    }
+}
@@ -2,17 +2,65 @@
 #include <iostream>
 #include <stdexcept>
 #include <algorithm> // for std::copy and std::swap
+#include <atomic>
+#include <complex>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "TParallel.h"
+#include "TTrace.h"
 
 static constexpr size_t MAX_VECTOR_SIZE = 100000000;
 
+// ограничение размера вектора во время выполнения (по умолчанию MAX_VECTOR_SIZE)
+size_t GetMaxVectorSize() noexcept;
+void SetMaxVectorSize(size_t sz) noexcept;
+
+// произведение размеров с проверкой переполнения (std::length_error)
+size_t CheckedMul(size_t a, size_t b);
+
+// начальная инициализация больших блоков памяти:
+// Serial - одним потоком, FirstTouch - непрерывными блоками по потокам (как делят работу ядра),
+// Interleaved - страницами по очереди между потоками
+enum class TAllocPolicy { Serial, FirstTouch, Interleaved };
+TAllocPolicy GetAllocPolicy() noexcept;
+void SetAllocPolicy(TAllocPolicy policy) noexcept;
+
+// порог в байтах, начиная с которого инициализация выполняется параллельно
+size_t GetParallelInitThreshold() noexcept;
+void SetParallelInitThreshold(size_t bytes) noexcept;
+
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+// число буферов векторов и матриц, выделенных текущим потоком (только в сборках
+// с TVECTOR_COUNT_ALLOCATIONS, например /DTVECTOR_COUNT_ALLOCATIONS для тестов)
+size_t GetVectorAllocationCount() noexcept;
+#endif
+
+// выделение sz элементов, инициализированных значением по умолчанию
+template<typename T>
+T* AllocateElements(size_t sz);
+
+namespace vector_detail
+{
+    // метка конструктора без инициализации элементов (их заполняет вызывающий)
+    struct TUninitialized {};
+}
+
 template<typename T>
 class TDynamicVector
 {
 protected:
     size_t size;
+    size_t capacity;   // элементов в буфере pMem (>= size)
     T* pMem;
+
+    void Reallocate(size_t cap);                    // перенос элементов в новый буфер на cap элементов
+    size_t GrowCapacity(size_t required) const;     // вместимость не меньше required с запасом
+    void ResetRange(size_t begin, size_t end);      // T() в [begin, end), если T владеет ресурсами
 public:
     TDynamicVector(size_t sz = 1);
+    TDynamicVector(size_t sz, vector_detail::TUninitialized);   // элементы тривиальных T не инициализированы
     TDynamicVector(T* arr, size_t sz);
     TDynamicVector(const TDynamicVector<T>& v);
     TDynamicVector(TDynamicVector<T>&& v) noexcept;
@@ -22,6 +70,16 @@ public:
     TDynamicVector<T>& operator=(TDynamicVector<T>&& v) noexcept;
 
     size_t GetSize() const noexcept { return size; }
+    size_t GetCapacity() const noexcept { return capacity; }
+
+    // вместимость: память перевыделяется, только когда её не хватает
+    void reserve(size_t cap);
+    void resize(size_t sz);                         // сохраняет элементы, новые - T()
+    void shrink_to_fit();
+    void push_back(const T& val);
+    void push_back(T&& val);
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
 
     T& operator[](size_t ind) noexcept;
     const T& operator[](size_t ind) const noexcept;
@@ -30,6 +88,7 @@ public:
 
     bool operator==(const TDynamicVector<T>& v) const noexcept;
     bool operator!=(const TDynamicVector<T>& v) const noexcept;
+    bool EqualsApprox(const TDynamicVector<T>& v, T tol) const noexcept; // |this[i] - v[i]| <= tol
 
     TDynamicVector<T> operator+(T val);
     TDynamicVector<T> operator-(T val);
@@ -37,11 +96,12 @@ public:
 
     TDynamicVector<T> operator+(const TDynamicVector<T>& v);
     TDynamicVector<T> operator-(const TDynamicVector<T>& v);
-    T operator*(const TDynamicVector<T>& v) noexcept(noexcept(T()));
+    T operator*(const TDynamicVector<T>& v);
 
     void swap(TDynamicVector<T>& lhs, TDynamicVector<T>& rhs) noexcept
     {
         std::swap(lhs.size, rhs.size);
+        std::swap(lhs.capacity, rhs.capacity);
         std::swap(lhs.pMem, rhs.pMem);
     }
 
@@ -70,4 +130,23 @@ public:
     }
 };
 
+// Поэлементные операции с политикой выполнения (policy::seq, policy::par, policy::par_unseq, policy::automatic,
+// policy::reproducible); операторы TDynamicVector выполняются с policy::automatic
+template<typename P, typename T>
+TDynamicVector<T> Add(P p, const TDynamicVector<T>& a, const TDynamicVector<T>& b);           // a + b
+template<typename P, typename T>
+TDynamicVector<T> Subtract(P p, const TDynamicVector<T>& a, const TDynamicVector<T>& b);      // a - b
+template<typename P, typename T>
+TDynamicVector<T> Add(P p, const TDynamicVector<T>& a, const std::type_identity_t<T>& val);      // a + val
+template<typename P, typename T>
+TDynamicVector<T> Subtract(P p, const TDynamicVector<T>& a, const std::type_identity_t<T>& val); // a - val
+template<typename P, typename T>
+TDynamicVector<T> Multiply(P p, const TDynamicVector<T>& a, const std::type_identity_t<T>& val); // a * val
+template<typename P, typename T>
+T Dot(P p, const TDynamicVector<T>& a, const TDynamicVector<T>& b);                           // a^T * b
+template<typename P, typename T>
+void Copy(P p, const TDynamicVector<T>& src, TDynamicVector<T>& dst);                         // dst = src
+template<typename P, typename T>
+bool Equal(P p, const TDynamicVector<T>& a, const TDynamicVector<T>& b);                      // a == b
+
 #include "TVector.tpp"
@@ -1,29 +1,563 @@
-﻿// -------------------- Constructors and destructor --------------------
+﻿// -------------------- Limits and allocation --------------------
+
+namespace vector_detail
+{
+    inline std::atomic<size_t>& MaxVectorSizeSetting() noexcept
+    {
+        static std::atomic<size_t> max_size{ MAX_VECTOR_SIZE };
+        return max_size;
+    }
+
+    inline std::atomic<TAllocPolicy>& AllocPolicySetting() noexcept
+    {
+        static std::atomic<TAllocPolicy> policy{ TAllocPolicy::FirstTouch };
+        return policy;
+    }
+
+    inline std::atomic<size_t>& ParallelInitThresholdSetting() noexcept
+    {
+        static std::atomic<size_t> threshold{ size_t(1) << 22 };
+        return threshold;
+    }
+
+    static constexpr size_t INIT_PAGE_SIZE = 4096;
+
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+    // буферов векторов и матриц, выделенных текущим потоком (только в тестовых сборках)
+    inline size_t& AllocationCounter() noexcept
+    {
+        thread_local size_t count = 0;
+        return count;
+    }
+#endif
+
+    /**
+     * @brief Выделение sz элементов без инициализации для тривиальных T (new T[sz]).
+     *
+     * С TVECTOR_COUNT_ALLOCATIONS выделение учитывается в счётчике потока.
+     */
+    template<typename T>
+    T* NewElements(size_t sz)
+    {
+        T* mem = new T[sz];
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+        AllocationCounter()++;
+#endif
+        return mem;
+    }
+
+    // элементы сравниваются побайтно, если равенство значений совпадает с равенством представлений
+    template<typename T>
+    constexpr bool BitwiseComparable = std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value;
+
+    /**
+     * @brief Копирование n элементов: memcpy для тривиально копируемых T, иначе std::copy.
+     */
+    template<typename T>
+    void CopyElements(T* dst, const T* src, size_t n)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            if (n == 0)
+            {
+                return;
+            }
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+        else
+        {
+            std::copy(src, src + n, dst);
+        }
+    }
+
+    /**
+     * @brief Сравнение n элементов: memcmp для целочисленных T, иначе поэлементно.
+     */
+    template<typename T>
+    bool EqualElements(const T* a, const T* b, size_t n) noexcept
+    {
+        if constexpr (BitwiseComparable<T>)
+        {
+            return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+        }
+        else
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                if (a[i] != b[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    /**
+     * @brief Произведение a * b для ядер.
+     */
+    template<typename T>
+    T Mul(const T& a, const T& b)
+    {
+        return a * b;
+    }
+
+    /**
+     * @brief Комплексное произведение по формуле (ac - bd) + i(ad + bc).
+     *
+     * std::complex::operator* в GCC/Clang вызывает __muldc3 с обработкой
+     * NaN и бесконечностей по Приложению G C99, что не встраивается и не
+     * векторизуется; ядра используют прямую формулу (как -fcx-limited-range).
+     */
+    template<typename U>
+    std::complex<U> Mul(const std::complex<U>& a, const std::complex<U>& b)
+    {
+        return std::complex<U>(a.real() * b.real() - a.imag() * b.imag(),
+            a.real() * b.imag() + a.imag() * b.real());
+    }
+
+    /**
+     * @brief Сопряжение: для вещественных T — само значение.
+     */
+    template<typename T>
+    T Conj(const T& a)
+    {
+        return a;
+    }
+
+    template<typename U>
+    std::complex<U> Conj(const std::complex<U>& a)
+    {
+        return std::conj(a);
+    }
+
+    static constexpr size_t DOT_LANES = 8;
+    static constexpr size_t EQUAL_BLOCK = size_t(1) << 14;
+
+    /**
+     * @brief Копирование n элементов блоками по политике P (см. ForChunks).
+     */
+    template<typename P, typename T>
+    void CopyElementsChunked(T* dst, const T* src, size_t n)
+    {
+        ForChunks<P>(n, sizeof(T), [dst, src](size_t begin, size_t end, size_t)
+        {
+            CopyElements(dst + begin, src + begin, end - begin);
+        });
+    }
+
+    /**
+     * @brief Новый вектор result[i] = op(i) размера n, заполняемый блоками по политике P.
+     *
+     * Результат выделяется без инициализации: каждый элемент записывается один
+     * раз, и первым к странице обращается поток, который её заполняет.
+     */
+    template<typename P, typename T, typename Op>
+    TDynamicVector<T> Generate(size_t n, Op op)
+    {
+        TDynamicVector<T> result(n, TUninitialized{});
+        T* pr = &result[0];
+        ForChunks<P>(n, sizeof(T), [pr, &op](size_t begin, size_t end, size_t)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                pr[i] = op(i);
+            }
+        });
+        return result;
+    }
+
+    /**
+     * @brief Скалярное произведение n элементов.
+     *
+     * При Unsequenced сумма накапливается в DOT_LANES независимых частичных
+     * суммах, что позволяет компилятору векторизовать цикл для вещественных T
+     * (результат может отличаться от последовательного порядком округлений).
+     */
+    template<bool Unsequenced, typename T>
+    T DotRange(const T* a, const T* b, size_t n)
+    {
+        if constexpr (Unsequenced)
+        {
+            T lanes[DOT_LANES] = {};
+            size_t i = 0;
+            for (; i + DOT_LANES <= n; i += DOT_LANES)
+            {
+                for (size_t l = 0; l < DOT_LANES; l++)
+                {
+                    lanes[l] += Mul(a[i + l], b[i + l]);
+                }
+            }
+            for (; i < n; i++)
+            {
+                lanes[0] += Mul(a[i], b[i]);
+            }
+            for (size_t width = DOT_LANES / 2; width > 0; width /= 2)
+            {
+                for (size_t l = 0; l < width; l++)
+                {
+                    lanes[l] += lanes[l + width];
+                }
+            }
+            return lanes[0];
+        }
+        else
+        {
+            T result = T();
+            for (size_t i = 0; i < n; i++)
+            {
+                result += Mul(a[i], b[i]);
+            }
+            return result;
+        }
+    }
+
+    // Воспроизводимые суммы ------------------------------------------------
+    //
+    // Сумма n слагаемых term(k) делится на блоки по REPRO_BLOCK; внутри блока
+    // слагаемое с номером k попадает в частичную сумму (k - начало блока) % DOT_LANES,
+    // частичные суммы складываются попарно, а суммы блоков — попарным деревом
+    // по номерам блоков. Форма дерева зависит только от n, поэтому результат не
+    // зависит от числа потоков, раскладки и ширины SIMD. Требуется, чтобы
+    // компилятор не объединял умножение и сложение в FMA и не переставлял
+    // сложения: для GCC ядра ниже компилируются с optimize("no-fast-math",
+    // "fp-contract=off"), для Clang - с "clang fp contract(off)" и
+    // "clang fp reassociate(off)" (при любых ключах компиляции). Для MSVC
+    // проект задаёт /fp:precise; с /fp:fast или /fp:contract воспроизводимые
+    // функции не компилируются.
+
+    static constexpr size_t REPRO_BLOCK = 256;
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_FP_FAST) || defined(_M_FP_CONTRACT))
+    // суммы с плавающей точкой при нестрогой модели MSVC не воспроизводимы
+    template<typename T>
+    constexpr bool ReproStrictFp = !std::is_floating_point<T>::value;
+    template<typename U>
+    constexpr bool ReproStrictFp<std::complex<U>> = false;
+#else
+    template<typename T>
+    constexpr bool ReproStrictFp = true;
+#endif
+
+#if defined(__clang__)
+#define TVECTOR_REPRO_NO_CONTRACT _Pragma("clang fp contract(off)") _Pragma("clang fp reassociate(off)")
+#else
+#define TVECTOR_REPRO_NO_CONTRACT
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("no-fast-math", "fp-contract=off")
+#endif
+
+    /**
+     * @brief Сумма блока [begin, end) по DOT_LANES частичным суммам.
+     */
+    template<typename T, typename Term>
+    T ReproBlockSum(size_t begin, size_t end, const Term& term)
+    {
+        TVECTOR_REPRO_NO_CONTRACT
+        static_assert(ReproStrictFp<T>,
+            "Reproducible sums require /fp:precise (no /fp:fast or /fp:contract)");
+        T lanes[DOT_LANES] = {};
+        size_t k = begin;
+        for (; k + DOT_LANES <= end; k += DOT_LANES)
+        {
+            for (size_t l = 0; l < DOT_LANES; l++)
+            {
+                lanes[l] += term(k + l);
+            }
+        }
+        for (size_t l = 0; k < end; k++, l++)
+        {
+            lanes[l] += term(k);
+        }
+        for (size_t width = DOT_LANES / 2; width > 0; width /= 2)
+        {
+            for (size_t l = 0; l < width; l++)
+            {
+                lanes[l] += lanes[l + width];
+            }
+        }
+        return lanes[0];
+    }
+
+    /**
+     * @brief Попарное дерево над блоками [lo, hi): leaf(b) — сумма блока b.
+     */
+    template<typename T, typename Leaf>
+    T ReproTree(size_t lo, size_t hi, const Leaf& leaf)
+    {
+        TVECTOR_REPRO_NO_CONTRACT
+        if (hi <= lo)
+        {
+            return T();
+        }
+        if (hi - lo == 1)
+        {
+            return leaf(lo);
+        }
+        size_t mid = lo + (hi - lo) / 2;
+        return ReproTree<T>(lo, mid, leaf) + ReproTree<T>(mid, hi, leaf);
+    }
+
+    /**
+     * @brief Воспроизводимая сумма term(0) + ... + term(n - 1) в вызывающем потоке.
+     */
+    template<typename T, typename Term>
+    T ReproSum(size_t n, const Term& term)
+    {
+        return ReproTree<T>(0, (n + REPRO_BLOCK - 1) / REPRO_BLOCK, [n, &term](size_t b)
+        {
+            return ReproBlockSum<T>(b * REPRO_BLOCK, std::min(n, (b + 1) * REPRO_BLOCK), term);
+        });
+    }
+
+    /**
+     * @brief Воспроизводимое скалярное произведение.
+     *
+     * Если работа достаточно велика (см. RunsParallel), суммы блоков считаются
+     * параллельно в массив и затем сворачиваются тем же деревом, что и ReproSum,
+     * поэтому результат совпадает с последовательным побитово.
+     */
+    template<typename T>
+    T ReproducibleDot(const T* a, const T* b, size_t n)
+    {
+        auto term = [a, b](size_t k) { return Mul(a[k], b[k]); };
+        if (!RunsParallel<policy::TReproducible>(n, sizeof(T)))
+        {
+            return ReproSum<T>(n, term);
+        }
+
+        size_t blocks = (n + REPRO_BLOCK - 1) / REPRO_BLOCK;
+        std::vector<T> sums(blocks);
+        ParallelFor(blocks, [n, &term, &sums](size_t begin, size_t end, size_t)
+        {
+            for (size_t blk = begin; blk < end; blk++)
+            {
+                sums[blk] = ReproBlockSum<T>(blk * REPRO_BLOCK, std::min(n, (blk + 1) * REPRO_BLOCK), term);
+            }
+        });
+        return ReproTree<T>(0, blocks, [&sums](size_t blk) { return sums[blk]; });
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#endif
+}
+
+/**
+ * @brief Текущее ограничение размера вектора.
+ *
+ * @return Максимально допустимое число элементов вектора.
+ */
+inline size_t GetMaxVectorSize() noexcept
+{
+    return vector_detail::MaxVectorSizeSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задание ограничения размера вектора.
+ *
+ * Действует на векторы, создаваемые после вызова.
+ *
+ * @param sz Максимально допустимое число элементов вектора.
+ */
+inline void SetMaxVectorSize(size_t sz) noexcept
+{
+    vector_detail::MaxVectorSizeSetting().store(sz, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Произведение размеров с проверкой переполнения.
+ *
+ * @param a Первый множитель.
+ * @param b Второй множитель.
+ * @throws std::length_error если произведение не помещается в size_t.
+ * @return a * b.
+ */
+inline size_t CheckedMul(size_t a, size_t b)
+{
+    if (a != 0 && b > std::numeric_limits<size_t>::max() / a)
+    {
+        throw std::length_error("Size computation overflows size_t");
+    }
+    return a * b;
+}
+
+/**
+ * @brief Текущая политика начальной инициализации памяти.
+ */
+inline TAllocPolicy GetAllocPolicy() noexcept
+{
+    return vector_detail::AllocPolicySetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задание политики начальной инициализации памяти.
+ *
+ * @param policy Новая политика.
+ */
+inline void SetAllocPolicy(TAllocPolicy policy) noexcept
+{
+    vector_detail::AllocPolicySetting().store(policy, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Порог параллельной инициализации (в байтах).
+ */
+inline size_t GetParallelInitThreshold() noexcept
+{
+    return vector_detail::ParallelInitThresholdSetting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задание порога параллельной инициализации.
+ *
+ * @param bytes Размер блока в байтах, начиная с которого инициализация параллельна.
+ */
+inline void SetParallelInitThreshold(size_t bytes) noexcept
+{
+    vector_detail::ParallelInitThresholdSetting().store(bytes, std::memory_order_relaxed);
+}
+
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+/**
+ * @brief Число буферов векторов и матриц, выделенных текущим потоком.
+ *
+ * Есть только в сборках с TVECTOR_COUNT_ALLOCATIONS (тесты); в обычных
+ * сборках выделения не учитываются. Учитываются буферы TDynamicVector (в том
+ * числе строки и массив строк TDynamicMatrix), но не другие выделения, например
+ * std::vector или std::function. Счётчик потоковый и только растёт: разность
+ * двух чтений вокруг участка кода показывает, сколько буферов он выделил.
+ */
+inline size_t GetVectorAllocationCount() noexcept
+{
+    return vector_detail::AllocationCounter();
+}
+#endif
+
+/**
+ * @brief Выделение sz элементов, инициализированных значением по умолчанию.
+ *
+ * Для тривиальных типов большие блоки выделяются без инициализации и
+ * обнуляются параллельно: ОС размещает страницу на NUMA-узле потока, который
+ * первым к ней обратился (first touch). При FirstTouch блок обнуляет тот же
+ * рабочий поток ParallelFor, который затем обрабатывает блок с теми же
+ * границами; потоки не привязаны к ядрам, так что совпадение узлов зависит от
+ * того, не перенесла ли их ОС. При Interleaved страницы раздаются потокам по
+ * очереди и распределяются по всем узлам.
+ * Остальные типы и небольшие блоки инициализируются как new T[sz]().
+ * Память освобождается через delete[].
+ *
+ * @tparam T Тип элементов.
+ * @param sz Количество элементов.
+ * @throws std::length_error если размер в байтах не помещается в size_t.
+ * @return Указатель на выделенную память.
+ */
+template<typename T>
+T* AllocateElements(size_t sz)
+{
+    size_t bytes = CheckedMul(sz, sizeof(T));
+    TAllocPolicy policy = GetAllocPolicy();
+
+    if (!std::is_trivial<T>::value || policy == TAllocPolicy::Serial ||
+        bytes < GetParallelInitThreshold() || InParallelRegion())
+    {
+        T* mem = new T[sz]();
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+        vector_detail::AllocationCounter()++;
+#endif
+        return mem;
+    }
+
+    T* mem = vector_detail::NewElements<T>(sz);
+    unsigned char* raw = reinterpret_cast<unsigned char*>(mem);
+
+    if (policy == TAllocPolicy::FirstTouch)
+    {
+        ParallelFor(sz, [mem](size_t begin, size_t end, size_t)
+        {
+            std::memset(static_cast<void*>(mem + begin), 0, (end - begin) * sizeof(T));
+        });
+    }
+    else
+    {
+        size_t pages = (bytes + vector_detail::INIT_PAGE_SIZE - 1) / vector_detail::INIT_PAGE_SIZE;
+        size_t threads = ParallelChunks(pages);
+        ParallelFor(threads, [raw, bytes, pages, threads](size_t begin, size_t end, size_t)
+        {
+            for (size_t t = begin; t < end; t++)
+            {
+                for (size_t page = t; page < pages; page += threads)
+                {
+                    size_t offset = page * vector_detail::INIT_PAGE_SIZE;
+                    size_t len = std::min(vector_detail::INIT_PAGE_SIZE, bytes - offset);
+                    std::memset(raw + offset, 0, len);
+                }
+            }
+        });
+    }
+    return mem;
+}
+
+
+// -------------------- Constructors and destructor --------------------
 
 /**
  * @brief Конструктор вектора заданного размера.
  *
- * Выделяет память под sz элементов типа T и инициализирует её значениями по умолчанию.
+ * Выделяет память под sz элементов типа T и инициализирует её значениями по умолчанию
+ * (большие блоки — параллельно, см. AllocateElements).
+ *
+ * @tparam T Тип элементов вектора.
+ * @param sz Желаемый размер вектора (должен быть > 0 и <= GetMaxVectorSize()).
+ * @throws std::out_of_range если sz == 0.
+ * @throws std::length_error если sz > GetMaxVectorSize() или размер в байтах переполняет size_t.
+ */
+template <class T>
+TDynamicVector<T>::TDynamicVector(size_t sz) : size(sz), capacity(sz)
+{
+    if (sz == 0)
+    {
+        throw std::out_of_range("Vector size should be greater than zero");
+    }
+
+    if (sz > GetMaxVectorSize())
+    {
+        throw std::length_error("Vector size exceeds maximum allowed size");
+    }
+
+    pMem = AllocateElements<T>(sz);
+}
+
+/**
+ * @brief Конструктор вектора заданного размера без инициализации элементов.
+ *
+ * Для тривиальных T память не обнуляется (new T[sz]), остальные типы
+ * создаются конструктором по умолчанию. Вызывающий должен записать все
+ * элементы до чтения.
  *
  * @tparam T Тип элементов вектора.
- * @param sz Желаемый размер вектора (должен быть > 0 и <= MAX_VECTOR_SIZE).
+ * @param sz Желаемый размер вектора (должен быть > 0 и <= GetMaxVectorSize()).
  * @throws std::out_of_range если sz == 0.
- * @throws std::length_error если sz > MAX_VECTOR_SIZE.
+ * @throws std::length_error если sz > GetMaxVectorSize() или размер в байтах переполняет size_t.
  */
 template <class T>
-TDynamicVector<T>::TDynamicVector(size_t sz) : size(sz)
+TDynamicVector<T>::TDynamicVector(size_t sz, vector_detail::TUninitialized) : size(sz), capacity(sz)
 {
     if (sz == 0)
     {
         throw std::out_of_range("Vector size should be greater than zero");
     }
 
-    if (sz > MAX_VECTOR_SIZE)
+    if (sz > GetMaxVectorSize())
     {
         throw std::length_error("Vector size exceeds maximum allowed size");
     }
 
-    pMem = new T[sz]();
+    CheckedMul(sz, sizeof(T));
+    pMem = vector_detail::NewElements<T>(sz);
 }
 
 /**
@@ -33,13 +567,13 @@ TDynamicVector<T>::TDynamicVector(size_t sz) : size(sz)
  *
  * @tparam T Тип элементов.
  * @param arr Указатель на входной массив (не должен быть nullptr).
- * @param sz Количество элементов для копирования (>0 и <= MAX_VECTOR_SIZE).
+ * @param sz Количество элементов для копирования (>0 и <= GetMaxVectorSize()).
  * @throws std::invalid_argument если arr == nullptr.
  * @throws std::out_of_range если sz == 0.
- * @throws std::length_error если sz > MAX_VECTOR_SIZE.
+ * @throws std::length_error если sz > GetMaxVectorSize() или размер в байтах переполняет size_t.
  */
 template <class T>
-TDynamicVector<T>::TDynamicVector(T* arr, size_t sz) : size(sz)
+TDynamicVector<T>::TDynamicVector(T* arr, size_t sz) : size(sz), capacity(sz)
 {
     if (arr == nullptr)
     {
@@ -51,28 +585,39 @@ TDynamicVector<T>::TDynamicVector(T* arr, size_t sz) : size(sz)
         throw std::out_of_range("Vector size should be greater than zero");
     }
 
-    if (sz > MAX_VECTOR_SIZE)
+    if (sz > GetMaxVectorSize())
     {
         throw std::length_error("Vector size exceeds maximum allowed size");
     }
 
-    pMem = new T[sz];
-    std::copy(arr, arr + sz, pMem);
+    CheckedMul(sz, sizeof(T));
+    pMem = vector_detail::NewElements<T>(sz);
+    vector_detail::CopyElements(pMem, arr, sz);
 }
 
 /**
  * @brief Копирующий конструктор.
  *
- * Выполняет глубокое копирование массива данных из v.
+ * Выполняет глубокое копирование массива данных из v
+ * (memcpy для тривиально копируемых T; большие векторы — параллельно
+ * с policy::automatic, так что страницы копии размещаются потоками, которые их обрабатывают).
  *
  * @tparam T Тип элементов.
  * @param v Вектор-источник для копирования.
  */
 template <class T>
-TDynamicVector<T>::TDynamicVector(const TDynamicVector<T>& v) : size(v.size)
+TDynamicVector<T>::TDynamicVector(const TDynamicVector<T>& v) : size(v.size), capacity(v.size)
 {
-    pMem = new T[size];
-    std::copy(v.pMem, v.pMem + size, pMem);
+    pMem = vector_detail::NewElements<T>(size);
+    try
+    {
+        vector_detail::CopyElementsChunked<policy::TAutomatic>(pMem, v.pMem, size);
+    }
+    catch (...)
+    {
+        delete[] pMem;
+        throw;
+    }
 }
 
 /**
@@ -85,12 +630,11 @@ TDynamicVector<T>::TDynamicVector(const TDynamicVector<T>& v) : size(v.size)
  * @note noexcept гарантируется.
  */
 template <class T>
-TDynamicVector<T>::TDynamicVector(TDynamicVector<T>&& v) noexcept : size(v.size), pMem(v.pMem)
+TDynamicVector<T>::TDynamicVector(TDynamicVector<T>&& v) noexcept : size(v.size), capacity(v.capacity), pMem(v.pMem)
 {
-    std::swap(v.size, size);
-    std::swap(v.pMem, pMem);
-    size = 0;
-    pMem = nullptr;
+    v.size = 0;
+    v.capacity = 0;
+    v.pMem = nullptr;
 }
 
 /**
@@ -116,8 +660,11 @@ TDynamicVector<T>::~TDynamicVector()
 /**
  * @brief Оператор копирующего присваивания.
  *
- * Реализует присваивание с обработкой изменения размера: при необходимости
- * выделяет новую память, копирует данные и освобождает старую память.
+ * Реализует присваивание с обработкой изменения размера: новая память
+ * выделяется, только если v не помещается в текущую вместимость, иначе
+ * буфер переиспользуется (в том числе при меньшем размере v).
+ * Для тривиально копируемых T данные копируются memcpy, большие векторы —
+ * параллельно с policy::automatic.
  *
  * @tparam T Тип элементов.
  * @param v Правый операнд присваивания.
@@ -128,17 +675,22 @@ TDynamicVector<T>& TDynamicVector<T>::operator=(const TDynamicVector<T>& v)
 {
     if (this != &v) // self-assignment check
     {
-        if (size != v.size)
+        if (capacity < v.size)
         {
             T* newMem = nullptr;
 
-            newMem = new T[v.size];
+            newMem = vector_detail::NewElements<T>(v.size);
 
             delete[] pMem; // free old memory
             pMem = newMem;
-            size = v.size;
+            capacity = v.size;
+        }
+        else if (v.size < size)
+        {
+            ResetRange(v.size, size);
         }
-        std::copy(v.pMem, v.pMem + size, pMem);
+        size = v.size;
+        vector_detail::CopyElementsChunked<policy::TAutomatic>(pMem, v.pMem, size);
     }
     return *this;
 }
@@ -162,14 +714,220 @@ TDynamicVector<T>& TDynamicVector<T>::operator=(TDynamicVector<T>&& v) noexcept
         delete[] pMem; // free old memory
         // Transfer ownership of memory
         size = v.size;
+        capacity = v.capacity;
         pMem = v.pMem;
         v.size = 0;
+        v.capacity = 0;
         v.pMem = nullptr;
     }
     return *this;
 }
 
 
+// -------------------- Capacity --------------------
+
+/**
+ * @brief Перенос элементов в новый буфер на cap элементов.
+ *
+ * Элементы перемещаются (memmove для тривиально копируемых T), старый
+ * буфер освобождается. При исключении во время переноса вектор не меняется.
+ *
+ * @tparam T Тип элементов.
+ * @param cap Новая вместимость (>= size).
+ * @throws std::length_error если размер в байтах переполняет size_t.
+ */
+template <class T>
+void TDynamicVector<T>::Reallocate(size_t cap)
+{
+    CheckedMul(cap, sizeof(T));
+    T* newMem = vector_detail::NewElements<T>(cap);
+    try
+    {
+        std::move(pMem, pMem + size, newMem);
+    }
+    catch (...)
+    {
+        delete[] newMem;
+        throw;
+    }
+    delete[] pMem;
+    pMem = newMem;
+    capacity = cap;
+}
+
+/**
+ * @brief Вместимость для роста до required элементов.
+ *
+ * Вместимость удваивается (не выше GetMaxVectorSize()), так что серия
+ * push_back выполняет O(log n) перевыделений и амортизированно O(1) на элемент.
+ *
+ * @tparam T Тип элементов.
+ * @param required Необходимое число элементов.
+ * @throws std::length_error если required > GetMaxVectorSize().
+ * @return Новая вместимость (>= required).
+ */
+template <class T>
+size_t TDynamicVector<T>::GrowCapacity(size_t required) const
+{
+    size_t limit = GetMaxVectorSize();
+    if (required > limit)
+    {
+        throw std::length_error("Vector size exceeds maximum allowed size");
+    }
+    size_t doubled = (capacity < limit / 2) ? capacity * 2 : limit;
+    return std::max(required, doubled);
+}
+
+/**
+ * @brief Сброс элементов [begin, end) за пределами размера в T().
+ *
+ * Освобождает ресурсы, которыми владеют элементы (например, строки
+ * вложенных векторов); для тривиально разрушаемых T ничего не делает.
+ *
+ * @tparam T Тип элементов.
+ */
+template <class T>
+void TDynamicVector<T>::ResetRange(size_t begin, size_t end)
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            pMem[i] = T();
+        }
+    }
+}
+
+/**
+ * @brief Резервирование вместимости.
+ *
+ * Если cap не больше текущей вместимости, ничего не делает; иначе элементы
+ * переносятся в буфер ровно на cap элементов. Размер не меняется.
+ *
+ * @tparam T Тип элементов.
+ * @param cap Желаемая вместимость.
+ * @throws std::length_error если cap > GetMaxVectorSize() или размер в байтах переполняет size_t.
+ */
+template <class T>
+void TDynamicVector<T>::reserve(size_t cap)
+{
+    if (cap <= capacity)
+    {
+        return;
+    }
+    if (cap > GetMaxVectorSize())
+    {
+        throw std::length_error("Vector size exceeds maximum allowed size");
+    }
+    Reallocate(cap);
+}
+
+/**
+ * @brief Изменение размера с сохранением элементов.
+ *
+ * Первые min(size, sz) элементов сохраняются, новые элементы равны T().
+ * Память перевыделяется (с удвоением вместимости) только при sz > GetCapacity();
+ * уменьшение размера буфер не освобождает (см. shrink_to_fit). Как и в
+ * конструкторе, размер 0 недопустим: вектор никогда не бывает пустым.
+ *
+ * @tparam T Тип элементов.
+ * @param sz Новый размер (> 0).
+ * @throws std::out_of_range если sz == 0.
+ * @throws std::length_error если sz > GetMaxVectorSize().
+ */
+template <class T>
+void TDynamicVector<T>::resize(size_t sz)
+{
+    if (sz == 0)
+    {
+        throw std::out_of_range("Vector size should be greater than zero");
+    }
+    if (sz > capacity)
+    {
+        Reallocate(GrowCapacity(sz));
+    }
+    if (sz > size)
+    {
+        std::fill(pMem + size, pMem + sz, T());
+    }
+    else
+    {
+        ResetRange(sz, size);
+    }
+    size = sz;
+}
+
+/**
+ * @brief Освобождение неиспользуемой вместимости.
+ *
+ * Элементы переносятся в буфер ровно на GetSize() элементов.
+ *
+ * @tparam T Тип элементов.
+ */
+template <class T>
+void TDynamicVector<T>::shrink_to_fit()
+{
+    if (capacity == size)
+    {
+        return;
+    }
+    Reallocate(size);
+}
+
+/**
+ * @brief Добавление элемента в конец (копия val).
+ *
+ * @tparam T Тип элементов.
+ * @param val Добавляемое значение (может быть элементом этого же вектора).
+ * @throws std::length_error если размер превысит GetMaxVectorSize().
+ */
+template <class T>
+void TDynamicVector<T>::push_back(const T& val)
+{
+    emplace_back(val);
+}
+
+/**
+ * @brief Добавление элемента в конец (перемещение val).
+ *
+ * @tparam T Тип элементов.
+ * @param val Добавляемое значение.
+ * @throws std::length_error если размер превысит GetMaxVectorSize().
+ */
+template <class T>
+void TDynamicVector<T>::push_back(T&& val)
+{
+    emplace_back(std::move(val));
+}
+
+/**
+ * @brief Создание элемента в конце из аргументов args.
+ *
+ * Элемент создаётся до возможного перевыделения, поэтому аргументы могут
+ * ссылаться на элементы этого же вектора. При нехватке вместимости она
+ * удваивается: амортизированно O(1) на элемент. Буфер хранит созданные по
+ * умолчанию объекты, поэтому новый элемент перемещается в свой слот.
+ *
+ * @tparam T Тип элементов.
+ * @tparam Args Типы аргументов конструктора T.
+ * @param args Аргументы конструктора T.
+ * @throws std::length_error если размер превысит GetMaxVectorSize().
+ * @return Ссылка на добавленный элемент.
+ */
+template <class T>
+template <typename... Args>
+T& TDynamicVector<T>::emplace_back(Args&&... args)
+{
+    T val(std::forward<Args>(args)...);
+    if (size == capacity)
+    {
+        Reallocate(GrowCapacity(size + 1));
+    }
+    pMem[size] = std::move(val);
+    return pMem[size++];
+}
+
+
 // -------------------- Element access --------------------
 
 /**
@@ -244,7 +1002,10 @@ const T& TDynamicVector<T>::at(size_t ind) const
 /**
  * @brief Оператор сравнения на равенство.
  *
- * Сравнивает размеры и попарно элементы векторов.
+ * Сравнивает размеры и попарно элементы векторов. Для целочисленных T
+ * (а также перечислений и указателей) элементы сравниваются одним memcmp;
+ * для вещественных — поэлементно, чтобы 0.0 == -0.0 и NaN != NaN.
+ * Большие векторы сравниваются параллельно (policy::automatic).
  *
  * @tparam T Тип элементов.
  * @param v Вектор для сравнения.
@@ -253,24 +1014,16 @@ const T& TDynamicVector<T>::at(size_t ind) const
 template <class T>
 bool TDynamicVector<T>::operator==(const TDynamicVector<T>& v) const noexcept
 {
-    bool result = true;
-
-    if (size != v.size)
+    TTRACE_SCOPE("TDynamicVector::operator==", size);
+    try
     {
-        result = false;
+        return Equal(policy::automatic, *this, v);
     }
-    else
+    catch (...)
     {
-        for (size_t i = 0; i < size; i++)
-        {
-            if (pMem[i] != v.pMem[i])
-            {
-                result = false;
-                break;
-            }
-        }
+        // потоки не удалось запустить - сравнение в вызывающем потоке
+        return size == v.size && vector_detail::EqualElements(pMem, v.pMem, size);
     }
-    return result;
 }
 
 /**
@@ -289,12 +1042,67 @@ bool TDynamicVector<T>::operator!=(const TDynamicVector<T>& v) const noexcept
 }
 
 
+/**
+ * @brief Сравнение с допуском.
+ *
+ * Векторы равны, если размеры совпадают и |this[i] - v[i]| <= tol для всех i
+ * (NaN не равен ничему). Элементы обрабатываются блоками фиксированной длины
+ * без ветвлений внутри блока, что позволяет компилятору векторизовать
+ * проверку; после каждого блока выполняется ранний выход.
+ *
+ * @tparam T Вещественный тип элементов.
+ * @param v Вектор для сравнения.
+ * @param tol Допуск (>= 0).
+ * @return true если векторы совпадают с точностью tol, иначе false.
+ */
+template <class T>
+bool TDynamicVector<T>::EqualsApprox(const TDynamicVector<T>& v, T tol) const noexcept
+{
+    static_assert(std::is_floating_point<T>::value, "EqualsApprox requires a floating-point element type");
+
+    if (size != v.size)
+    {
+        return false;
+    }
+
+    constexpr size_t BLOCK = 16;
+    const T* a = pMem;
+    const T* b = v.pMem;
+    size_t i = 0;
+
+    for (; i + BLOCK <= size; i += BLOCK)
+    {
+        bool mismatch = false;
+        for (size_t j = 0; j < BLOCK; j++)
+        {
+            T d = a[i + j] - b[i + j];
+            mismatch |= !((d <= tol) & (-d <= tol));
+        }
+        if (mismatch)
+        {
+            return false;
+        }
+    }
+
+    for (; i < size; i++)
+    {
+        T d = a[i] - b[i];
+        if (!(d <= tol && -d <= tol))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 // -------------------- Scalar operations --------------------
 
 /**
  * @brief Побитовое/арифметическое (элементное) прибавление скаляра.
  *
  * Возвращает новый вектор, в котором к каждому элементу добавлен val.
+ * Выполняется с policy::automatic (см. Add).
  *
  * @tparam T Тип элементов.
  * @param val Скаляр для прибавления.
@@ -303,18 +1111,15 @@ bool TDynamicVector<T>::operator!=(const TDynamicVector<T>& v) const noexcept
 template <class T>
 TDynamicVector<T> TDynamicVector<T>::operator+(T val)
 {
-    TDynamicVector<T> result(size);
-    for (size_t i = 0; i < size; i++)
-    {
-        result.pMem[i] = pMem[i] + val;
-    }
-    return result;
+    TTRACE_SCOPE("TDynamicVector::operator+(T)", size);
+    return Add(policy::automatic, *this, val);
 }
 
 /**
  * @brief Элементное вычитание скаляра.
  *
  * Возвращает новый вектор, из каждого элемента которого вычтен val.
+ * Выполняется с policy::automatic (см. Subtract).
  *
  * @tparam T Тип элементов.
  * @param val Скаляр для вычитания.
@@ -323,18 +1128,15 @@ TDynamicVector<T> TDynamicVector<T>::operator+(T val)
 template <class T>
 TDynamicVector<T> TDynamicVector<T>::operator-(T val)
 {
-    TDynamicVector<T> result(size);
-    for (size_t i = 0; i < size; i++)
-    {
-        result.pMem[i] = pMem[i] - val;
-    }
-    return result;
+    TTRACE_SCOPE("TDynamicVector::operator-(T)", size);
+    return Subtract(policy::automatic, *this, val);
 }
 
 /**
  * @brief Элементное умножение на скаляр.
  *
  * Возвращает новый вектор, где каждый элемент умножен на val.
+ * Выполняется с policy::automatic (см. Multiply).
  *
  * @tparam T Тип элементов.
  * @param val Скаляр для умножения.
@@ -343,12 +1145,8 @@ TDynamicVector<T> TDynamicVector<T>::operator-(T val)
 template <class T>
 TDynamicVector<T> TDynamicVector<T>::operator*(T val)
 {
-    TDynamicVector<T> result(size);
-    for (size_t i = 0; i < size; i++)
-    {
-        result.pMem[i] = pMem[i] * val;
-    }
-    return result;
+    TTRACE_SCOPE("TDynamicVector::operator*(T)", size);
+    return Multiply(policy::automatic, *this, val);
 }
 
 
@@ -358,6 +1156,7 @@ TDynamicVector<T> TDynamicVector<T>::operator*(T val)
  * @brief Сложение двух векторов.
  *
  * Выполняет поэлементное сложение; размеры векторов должны совпадать.
+ * Выполняется с policy::automatic (см. Add).
  *
  * @tparam T Тип элементов.
  * @param v Правый вектор для сложения.
@@ -367,22 +1166,15 @@ TDynamicVector<T> TDynamicVector<T>::operator*(T val)
 template <class T>
 TDynamicVector<T> TDynamicVector<T>::operator+(const TDynamicVector<T>& v)
 {
-    if (size != v.size)
-    {
-        throw std::invalid_argument("Vectors must be of the same size for addition");
-    }
-    TDynamicVector<T> result(size);
-    for (size_t i = 0; i < size; i++)
-    {
-        result.pMem[i] = pMem[i] + v.pMem[i];
-    }
-    return result;
+    TTRACE_SCOPE("TDynamicVector::operator+(vector)", size);
+    return Add(policy::automatic, *this, v);
 }
 
 /**
  * @brief Вычитание двух векторов.
  *
  * Выполняет поэлементное вычитание; размеры векторов должны совпадать.
+ * Выполняется с policy::automatic (см. Subtract).
  *
  * @tparam T Тип элементов.
  * @param v Правый вектор для вычитания.
@@ -392,16 +1184,8 @@ TDynamicVector<T> TDynamicVector<T>::operator+(const TDynamicVector<T>& v)
 template <class T>
 TDynamicVector<T> TDynamicVector<T>::operator-(const TDynamicVector<T>& v)
 {
-    if (size != v.size)
-    {
-        throw std::invalid_argument("Vectors must be of the same size for subtraction");
-    }
-    TDynamicVector<T> result(size);
-    for (size_t i = 0; i < size; i++)
-    {
-        result.pMem[i] = pMem[i] - v.pMem[i];
-    }
-    return result;
+    TTRACE_SCOPE("TDynamicVector::operator-(vector)", size);
+    return Subtract(policy::automatic, *this, v);
 }
 
 
@@ -411,25 +1195,253 @@ TDynamicVector<T> TDynamicVector<T>::operator-(const TDynamicVector<T>& v)
  * @brief Скалярное (dot) произведение двух векторов.
  *
  * Вычисляет суммарное произведение соответствующих элементов.
+ * Выполняется с policy::automatic, в режиме SetReproducibleReductions(true) —
+ * с policy::reproducible (см. Dot).
  *
  * @tparam T Тип элементов (должен поддерживать операцию умножения и сложения).
  * @param v Вектор-правый операнд.
  * @throws std::invalid_argument если размеры векторов не совпадают.
  * @return Скаляр типа T — результат скалярного произведения.
- * @note noexcept спецификация зависит от noexcept(T()) — если конструктор T() noexcept,
- *       то функция помечается noexcept.
  */
 template <class T>
-T TDynamicVector<T>::operator*(const TDynamicVector<T>& v) noexcept(noexcept(T()))
+T TDynamicVector<T>::operator*(const TDynamicVector<T>& v)
 {
-    if (size != v.size)
+    TTRACE_SCOPE("TDynamicVector::operator*(vector)", size);
+    if (GetReproducibleReductions())
+    {
+        return Dot(policy::reproducible, *this, v);
+    }
+    return Dot(policy::automatic, *this, v);
+}
+
+
+// -------------------- Execution policies --------------------
+
+/**
+ * @brief Сложение векторов с политикой выполнения.
+ *
+ * Работа делится на непрерывные блоки по потокам (см. ForChunks); с
+ * policy::seq выполняется в вызывающем потоке, с policy::automatic —
+ * параллельно начиная с GetAutoParallelThreshold() байт.
+ *
+ * @tparam P Тип политики выполнения.
+ * @tparam T Тип элементов.
+ * @param p Политика выполнения.
+ * @param a Левый вектор.
+ * @param b Правый вектор.
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Новый вектор a + b.
+ */
+template<typename P, typename T>
+TDynamicVector<T> Add(P, const TDynamicVector<T>& a, const TDynamicVector<T>& b)
+{
+    TTRACE_SCOPE("Add(vector)", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for addition");
+    }
+    const T* pa = &a[0];
+    const T* pb = &b[0];
+    return vector_detail::Generate<P, T>(a.GetSize(), [pa, pb](size_t i) { return pa[i] + pb[i]; });
+}
+
+/**
+ * @brief Вычитание векторов с политикой выполнения (см. Add).
+ *
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Новый вектор a - b.
+ */
+template<typename P, typename T>
+TDynamicVector<T> Subtract(P, const TDynamicVector<T>& a, const TDynamicVector<T>& b)
+{
+    TTRACE_SCOPE("Subtract(vector)", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        throw std::invalid_argument("Vectors must be of the same size for subtraction");
+    }
+    const T* pa = &a[0];
+    const T* pb = &b[0];
+    return vector_detail::Generate<P, T>(a.GetSize(), [pa, pb](size_t i) { return pa[i] - pb[i]; });
+}
+
+/**
+ * @brief Прибавление скаляра с политикой выполнения (см. Add).
+ *
+ * @return Новый вектор a + val.
+ */
+template<typename P, typename T>
+TDynamicVector<T> Add(P, const TDynamicVector<T>& a, const std::type_identity_t<T>& val)
+{
+    TTRACE_SCOPE("Add(scalar)", a.GetSize());
+    const T* pa = &a[0];
+    return vector_detail::Generate<P, T>(a.GetSize(), [pa, &val](size_t i) { return pa[i] + val; });
+}
+
+/**
+ * @brief Вычитание скаляра с политикой выполнения (см. Add).
+ *
+ * @return Новый вектор a - val.
+ */
+template<typename P, typename T>
+TDynamicVector<T> Subtract(P, const TDynamicVector<T>& a, const std::type_identity_t<T>& val)
+{
+    TTRACE_SCOPE("Subtract(scalar)", a.GetSize());
+    const T* pa = &a[0];
+    return vector_detail::Generate<P, T>(a.GetSize(), [pa, &val](size_t i) { return pa[i] - val; });
+}
+
+/**
+ * @brief Умножение на скаляр с политикой выполнения (см. Add).
+ *
+ * @return Новый вектор a * val.
+ */
+template<typename P, typename T>
+TDynamicVector<T> Multiply(P, const TDynamicVector<T>& a, const std::type_identity_t<T>& val)
+{
+    TTRACE_SCOPE("Multiply(scalar)", a.GetSize());
+    const T* pa = &a[0];
+    return vector_detail::Generate<P, T>(a.GetSize(), [pa, &val](size_t i) { return vector_detail::Mul(pa[i], val); });
+}
+
+/**
+ * @brief Скалярное произведение с политикой выполнения.
+ *
+ * При параллельном исполнении каждый поток считает частичную сумму своего
+ * блока, частичные суммы складываются в порядке блоков. С policy::par_unseq
+ * внутри блока используются независимые частичные суммы (векторизация), поэтому
+ * для вещественных T результат может отличаться от policy::seq в последних разрядах.
+ * С policy::reproducible сумма считается по фиксированному дереву (см.
+ * vector_detail::ReproSum) и побитово одинакова при любом числе потоков; цена —
+ * массив сумм блоков и их свёртка; на векторе 2·10^7 double (одно ядро, -O3)
+ * примерно +10% к policy::seq и +40% к policy::par_unseq.
+ *
+ * @tparam P Тип политики выполнения.
+ * @tparam T Тип элементов.
+ * @param p Политика выполнения.
+ * @param a Левый вектор.
+ * @param b Правый вектор.
+ * @throws std::invalid_argument если размеры не совпадают.
+ * @return Скалярное произведение.
+ */
+template<typename P, typename T>
+T Dot(P, const TDynamicVector<T>& a, const TDynamicVector<T>& b)
+{
+    TTRACE_SCOPE("Dot", a.GetSize());
+    if (a.GetSize() != b.GetSize())
     {
         throw std::invalid_argument("Vectors must be of the same size for dot product");
     }
+
+    constexpr bool unseq = std::is_same<P, policy::TParallelUnsequenced>::value;
+    const size_t n = a.GetSize();
+    const T* pa = &a[0];
+    const T* pb = &b[0];
+    if constexpr (std::is_same<P, policy::TReproducible>::value)
+    {
+        return vector_detail::ReproducibleDot(pa, pb, n);
+    }
+
+    if (!RunsParallel<P>(n, sizeof(T)))
+    {
+        return vector_detail::DotRange<unseq>(pa, pb, n);
+    }
+
+    std::vector<T> partial(ParallelChunks(n), T());
+    ParallelFor(n, [pa, pb, &partial](size_t begin, size_t end, size_t chunk)
+    {
+        partial[chunk] = vector_detail::DotRange<unseq>(pa + begin, pb + begin, end - begin);
+    });
+
     T result = T();
-    for (size_t i = 0; i < size; i++)
+    for (const T& s : partial)
     {
-        result += pMem[i] * v.pMem[i];
+        result += s;
     }
     return result;
 }
+
+/**
+ * @brief Копирование с политикой выполнения: dst = src.
+ *
+ * dst перевыделяется без инициализации, только если src не помещается в
+ * его вместимость (как при присваивании); иначе буфер dst переиспользуется.
+ * Пустой src (например, после перемещения) делает dst пустым, как присваивание.
+ *
+ * @tparam P Тип политики выполнения.
+ * @tparam T Тип элементов.
+ * @param p Политика выполнения.
+ * @param src Вектор-источник.
+ * @param dst Вектор-приёмник.
+ */
+template<typename P, typename T>
+void Copy(P, const TDynamicVector<T>& src, TDynamicVector<T>& dst)
+{
+    TTRACE_SCOPE("Copy", src.GetSize());
+    if (&src == &dst)
+    {
+        return;
+    }
+    if (src.GetSize() == 0)
+    {
+        dst = src;
+        return;
+    }
+    if (dst.GetCapacity() < src.GetSize())
+    {
+        dst = TDynamicVector<T>(src.GetSize(), vector_detail::TUninitialized{});
+    }
+    else
+    {
+        dst.resize(src.GetSize());
+    }
+    vector_detail::CopyElementsChunked<P>(&dst[0], &src[0], src.GetSize());
+}
+
+/**
+ * @brief Сравнение на равенство с политикой выполнения.
+ *
+ * При параллельном исполнении блоки потоков сравниваются частями по
+ * EQUAL_BLOCK элементов; первое найденное различие останавливает все потоки.
+ *
+ * @tparam P Тип политики выполнения.
+ * @tparam T Тип элементов.
+ * @param p Политика выполнения.
+ * @param a Левый вектор.
+ * @param b Правый вектор.
+ * @return true если размеры и все элементы равны.
+ */
+template<typename P, typename T>
+bool Equal(P, const TDynamicVector<T>& a, const TDynamicVector<T>& b)
+{
+    TTRACE_SCOPE("Equal", a.GetSize());
+    if (a.GetSize() != b.GetSize())
+    {
+        return false;
+    }
+
+    const size_t n = a.GetSize();
+    if (n == 0)
+    {
+        return true;   // пустые (перемещённые) векторы: буферов нет
+    }
+    const T* pa = &a[0];
+    const T* pb = &b[0];
+    if (!RunsParallel<P>(n, sizeof(T)))
+    {
+        return vector_detail::EqualElements(pa, pb, n);
+    }
+
+    std::atomic<bool> mismatch{ false };
+    ParallelFor(n, [pa, pb, &mismatch](size_t begin, size_t end, size_t)
+    {
+        for (size_t i = begin; i < end && !mismatch.load(std::memory_order_relaxed); i += vector_detail::EQUAL_BLOCK)
+        {
+            size_t len = std::min(vector_detail::EQUAL_BLOCK, end - i);
+            if (!vector_detail::EqualElements(pa + i, pb + i, len))
+            {
+                mismatch.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    return !mismatch.load();
+}
@@ -0,0 +1,186 @@
+﻿#include "TAsync.h"
+#include <gtest/gtest.h>
+#include <complex>
+#include <limits>
+
+// -------------------- Async tests --------------------
+
+/**
+ * @brief Вспомогательная функция: матрица с элементами i * n + j.
+ */
+static TDynamicMatrix<int> make_async_test_matrix(size_t n)
+{
+    TDynamicMatrix<int> m(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            m[i][j] = static_cast<int>(i * n + j);
+    return m;
+}
+
+/**
+ * @brief Тест: асинхронное умножение матриц совпадает с синхронным.
+ */
+TEST(TAsync, async_multiply_matches_sync_multiply)
+{
+    TThreadPoolExecutor pool(4);
+    TDynamicMatrix<int> m = make_async_test_matrix(20);
+    TDynamicMatrix<int> m1 = make_async_test_matrix(20);
+    TAsyncResult<TDynamicMatrix<int>> r = AsyncMultiply(m, m1, pool);
+    EXPECT_EQ(m * m1, r.Get());
+    EXPECT_DOUBLE_EQ(1.0, r.GetProgress());
+}
+
+/**
+ * @brief Тест: асинхронное умножение матрицы на вектор совпадает с синхронным.
+ */
+TEST(TAsync, async_multiply_matrix_by_vector_matches_sync)
+{
+    TThreadPoolExecutor pool(3);
+    TDynamicMatrix<int> m = make_async_test_matrix(15);
+    TDynamicVector<int> v(15);
+    for (size_t i = 0; i < v.GetSize(); i++)
+        v[i] = static_cast<int>(i) - 7;
+    EXPECT_EQ(m * v, AsyncMultiply(m, v, pool).Get());
+}
+
+/**
+ * @brief Тест: асинхронное сложение матриц совпадает с синхронным.
+ */
+TEST(TAsync, async_add_matches_sync_add)
+{
+    TInlineExecutor inline_ex;
+    TDynamicMatrix<int> m = make_async_test_matrix(7);
+    TDynamicMatrix<int> m1 = make_async_test_matrix(7);
+    TAsyncResult<TDynamicMatrix<int>> r = AsyncAdd(m, m1, inline_ex);
+    EXPECT_TRUE(r.IsReady());
+    EXPECT_EQ(m + m1, r.Get());
+}
+
+/**
+ * @brief Тест: несовпадение размеров сообщается синхронно.
+ */
+TEST(TAsync, async_multiply_throws_on_not_equal_size)
+{
+    TDynamicMatrix<int> m(5);
+    TDynamicMatrix<int> m1(10);
+    ASSERT_ANY_THROW(AsyncMultiply(m, m1));
+}
+
+/**
+ * @brief Тест: конвейер (a * b) + (a * b) вычисляется без промежуточных ожиданий.
+ */
+TEST(TAsync, can_chain_operations_into_pipeline)
+{
+    TThreadPoolExecutor pool(4);
+    TDynamicMatrix<int> m = make_async_test_matrix(10);
+    TAsyncResult<TDynamicMatrix<int>> p1 = AsyncMultiply(m, m, pool);
+    TAsyncResult<TDynamicMatrix<int>> p2 = AsyncMultiply(m, m, pool);
+    TAsyncResult<TDynamicMatrix<int>> sum = AsyncAdd(p1, p2, pool);
+    TDynamicMatrix<int> mm = m * m;
+    EXPECT_EQ(mm + mm, sum.Get());
+}
+
+/**
+ * @brief Тест: продолжение Then получает результат предыдущей операции.
+ */
+TEST(TAsync, then_receives_previous_result)
+{
+    TThreadPoolExecutor pool(2);
+    TDynamicMatrix<int> m = make_async_test_matrix(4);
+    TAsyncResult<int> trace = AsyncMultiply(m, m, pool).Then(
+        [](TDynamicMatrix<int>& r)
+        {
+            int t = 0;
+            for (size_t i = 0; i < r.GetSize(); i++)
+                t += r[i][i];
+            return t;
+        }, pool);
+    TDynamicMatrix<int> mm = m * m;
+    int expected = 0;
+    for (size_t i = 0; i < mm.GetSize(); i++)
+        expected += mm[i][i];
+    EXPECT_EQ(expected, trace.Get());
+}
+
+/**
+ * @brief Тест: ошибка зависимости переносится в результат конвейера.
+ */
+TEST(TAsync, pipeline_propagates_errors)
+{
+    TThreadPoolExecutor pool(2);
+    TDynamicMatrix<int> m(5);
+    TDynamicMatrix<int> m1(6);
+    TAsyncResult<TDynamicMatrix<int>> a = AsyncMultiply(m, m, pool);
+    TAsyncResult<TDynamicMatrix<int>> b = AsyncMultiply(m1, m1, pool);
+    TAsyncResult<TDynamicMatrix<int>> c = AsyncMultiply(a, b, pool);
+    ASSERT_THROW(c.Get(), std::invalid_argument);
+}
+
+/**
+ * @brief Тест: отменённая до запуска операция завершается TOperationCancelled.
+ */
+TEST(TAsync, cancelled_operation_throws_operation_cancelled)
+{
+    TThreadPoolExecutor pool(2);
+    TDynamicMatrix<int> m = make_async_test_matrix(5);
+    TAsyncResult<TDynamicMatrix<int>> gate;
+    TAsyncResult<TDynamicMatrix<int>> r = AsyncMultiply(gate, gate, pool);
+    r.Cancel();
+    gate.GetState()->SetValue(TDynamicMatrix<int>(m));
+    EXPECT_TRUE(r.IsCancelled());
+    ASSERT_THROW(r.Get(), TOperationCancelled);
+}
+
+/**
+ * @brief Тест: асинхронные операции над матрицами TColMajor совпадают с синхронными.
+ */
+TEST(TAsync, col_major_operations_match_sync)
+{
+    TThreadPoolExecutor pool(3);
+    TDynamicMatrix<int, TColMajor> m(make_async_test_matrix(9));
+    TDynamicMatrix<int, TColMajor> m1(make_async_test_matrix(9));
+    m1[0][8] = -5;
+    TDynamicVector<int> v(9);
+    for (size_t i = 0; i < v.GetSize(); i++)
+        v[i] = static_cast<int>(i) - 4;
+
+    TAsyncResult<TDynamicMatrix<int, TColMajor>> prod = AsyncMultiply(m, m1, pool);
+    TAsyncResult<TDynamicMatrix<int, TColMajor>> sum = AsyncAdd(m, m1, pool);
+    EXPECT_TRUE(m * m1 == prod.Get());
+    EXPECT_TRUE(m + m1 == sum.Get());
+    EXPECT_EQ(m * v, AsyncMultiply(m, v, pool).Get());
+    EXPECT_TRUE((m * m1) * (m + m1) == AsyncMultiply(prod, sum, pool).Get());
+}
+
+/**
+ * @brief Тест: асинхронные комплексные произведения совпадают с синхронными, включая бесконечности.
+ */
+TEST(TAsync, complex_products_match_sync_with_infinities)
+{
+    using C = std::complex<double>;
+    const double inf = std::numeric_limits<double>::infinity();
+    TThreadPoolExecutor pool(2);
+    TDynamicMatrix<C> a(3), b(3);
+    for (size_t i = 0; i < 3; i++)
+        for (size_t j = 0; j < 3; j++)
+        {
+            a[i][j] = C(0.1 * (i + 1), 0.3 * j);
+            b[i][j] = C(1.0 + j, 0.7 * (i + 1));
+        }
+    a[0][0] = C(inf, 0.0);
+    TDynamicVector<C> v(3);
+    v[0] = C(1.0, 1.0);
+    v[1] = C(0.5, 0.0);
+    v[2] = C(-2.0, 0.25);
+
+    TDynamicMatrix<C> c = AsyncMultiply(a, b, pool).Get();
+    EXPECT_EQ(C(inf, inf), c[0][0]);
+    EXPECT_TRUE(a * b == c);
+    EXPECT_EQ(a * v, AsyncMultiply(a, v, pool).Get());
+
+    TDynamicMatrix<C, TColMajor> ac(a), bc(b);
+    EXPECT_TRUE(ac * bc == AsyncMultiply(ac, bc, pool).Get());
+    EXPECT_EQ(ac * v, AsyncMultiply(ac, v, pool).Get());
+}
+
+// End of tests
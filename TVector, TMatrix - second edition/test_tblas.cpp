@@ -0,0 +1,227 @@
+﻿#include "TBlas.h"
+#include <gtest/gtest.h>
+
+// -------------------- BLAS tests --------------------
+
+// -------------------- Level 1 tests --------------------
+
+/**
+ * @brief Тест: axpy вычисляет y = alpha * x + y на месте.
+ */
+TEST(TBlas, axpy_updates_y_in_place)
+{
+    TDynamicVector<int> x(4);
+    TDynamicVector<int> y(4);
+    for (size_t i = 0; i < x.GetSize(); i++)
+    {
+        x[i] = i + 1;
+        y[i] = 10;
+    }
+    axpy(2, x, y);
+    EXPECT_EQ(12, y[0]);
+    EXPECT_EQ(18, y[3]);
+}
+
+/**
+ * @brief Тест: axpy для векторов разного размера должен бросать.
+ */
+TEST(TBlas, axpy_throws_on_not_equal_size)
+{
+    TDynamicVector<int> x(4);
+    TDynamicVector<int> y(5);
+    ASSERT_ANY_THROW(axpy(1, x, y));
+}
+
+/**
+ * @brief Тест: scal умножает вектор на скаляр на месте.
+ */
+TEST(TBlas, scal_scales_vector_in_place)
+{
+    TDynamicVector<int> x(3);
+    for (size_t i = 0; i < x.GetSize(); i++)
+        x[i] = i + 1;
+    scal(3, x);
+    EXPECT_EQ(3, x[0]);
+    EXPECT_EQ(9, x[2]);
+}
+
+/**
+ * @brief Тест: dot совпадает с оператором скалярного произведения.
+ */
+TEST(TBlas, dot_matches_vector_operator)
+{
+    TDynamicVector<int> x(5);
+    TDynamicVector<int> y(5);
+    for (size_t i = 0; i < x.GetSize(); i++)
+    {
+        x[i] = i + 1;
+        y[i] = (i + 1) * 10;
+    }
+    EXPECT_EQ(x * y, dot(x, y));
+}
+
+// -------------------- Level 2 tests --------------------
+
+/**
+ * @brief Тест: gemv вычисляет y = alpha * A * x + beta * y.
+ */
+TEST(TBlas, gemv_computes_alpha_ax_plus_beta_y)
+{
+    TDynamicMatrix<int> a(2);
+    a[0][0] = 1; a[0][1] = 2;
+    a[1][0] = 3; a[1][1] = 4;
+    TDynamicVector<int> x(2);
+    x[0] = 5; x[1] = 6;
+    TDynamicVector<int> y(2);
+    y[0] = 1; y[1] = 2;
+    gemv(2, a, x, 3, y);
+    EXPECT_EQ(2 * 17 + 3 * 1, y[0]);
+    EXPECT_EQ(2 * 39 + 3 * 2, y[1]);
+}
+
+/**
+ * @brief Тест: gemv с совпадающими входом и выходом должен бросать.
+ */
+TEST(TBlas, gemv_throws_when_input_aliases_output)
+{
+    TDynamicMatrix<int> a(3);
+    TDynamicVector<int> x(3);
+    ASSERT_ANY_THROW(gemv(1, a, x, 0, x));
+}
+
+/**
+ * @brief Тест: ger добавляет внешнее произведение к матрице.
+ */
+TEST(TBlas, ger_adds_outer_product)
+{
+    TDynamicMatrix<int> a(2);
+    a[0][0] = 1; a[0][1] = 1;
+    a[1][0] = 1; a[1][1] = 1;
+    TDynamicVector<int> x(2);
+    x[0] = 1; x[1] = 2;
+    TDynamicVector<int> y(2);
+    y[0] = 3; y[1] = 4;
+    ger(2, x, y, a);
+    EXPECT_EQ(7, a[0][0]);
+    EXPECT_EQ(9, a[0][1]);
+    EXPECT_EQ(13, a[1][0]);
+    EXPECT_EQ(17, a[1][1]);
+}
+
+// -------------------- Level 3 tests --------------------
+
+/**
+ * @brief Тест: gemm с alpha = 1, beta = 0 совпадает с оператором умножения.
+ */
+TEST(TBlas, gemm_matches_matrix_operator)
+{
+    TDynamicMatrix<int> a(6);
+    TDynamicMatrix<int> b(6);
+    for (size_t i = 0; i < a.GetSize(); i++)
+        for (size_t j = 0; j < a.GetSize(); j++)
+        {
+            a[i][j] = i * 6 + j;
+            b[i][j] = (i + j) % 5;
+        }
+    TDynamicMatrix<int> c(6);
+    gemm(1, a, b, 0, c);
+    EXPECT_EQ(a * b, c);
+}
+
+/**
+ * @brief Тест: gemm вычисляет C = alpha * A * B + beta * C.
+ */
+TEST(TBlas, gemm_computes_alpha_ab_plus_beta_c)
+{
+    TDynamicMatrix<int> a(2);
+    a[0][0] = 1; a[0][1] = 2;
+    a[1][0] = 3; a[1][1] = 4;
+    TDynamicMatrix<int> b(2);
+    b[0][0] = 5; b[0][1] = 6;
+    b[1][0] = 7; b[1][1] = 8;
+    TDynamicMatrix<int> c(2);
+    c[0][0] = 1; c[0][1] = 1;
+    c[1][0] = 1; c[1][1] = 1;
+    gemm(2, a, b, 10, c);
+    EXPECT_EQ(48, c[0][0]);
+    EXPECT_EQ(54, c[0][1]);
+    EXPECT_EQ(96, c[1][0]);
+    EXPECT_EQ(110, c[1][1]);
+}
+
+/**
+ * @brief Тест: gemm для матриц разного размера должен бросать.
+ */
+TEST(TBlas, gemm_throws_on_not_equal_size)
+{
+    TDynamicMatrix<int> a(3);
+    TDynamicMatrix<int> b(4);
+    TDynamicMatrix<int> c(3);
+    ASSERT_ANY_THROW(gemm(1, a, b, 0, c));
+}
+
+/**
+ * @brief Тест: gemm с результатом, совпадающим с операндом, должен бросать.
+ */
+TEST(TBlas, gemm_throws_when_output_aliases_input)
+{
+    TDynamicMatrix<int> a(3);
+    TDynamicMatrix<int> b(3);
+    ASSERT_ANY_THROW(gemm(1, a, b, 0, a));
+}
+
+
+// -------------------- Layout tests --------------------
+
+/**
+ * @brief Тест: gemm совпадает при любых раскладках операндов и результата.
+ */
+TEST(TBlas, gemm_matches_for_all_layouts)
+{
+    TDynamicMatrix<int> a(7);
+    TDynamicMatrix<int> b(7);
+    for (size_t i = 0; i < a.GetSize(); i++)
+        for (size_t j = 0; j < a.GetSize(); j++)
+        {
+            a[i][j] = (i * 5 + j) % 7 - 3;
+            b[i][j] = (i + j * 2) % 5 - 2;
+        }
+    TDynamicMatrix<int, TColMajor> ac(a);
+    TDynamicMatrix<int, TColMajor> bc(b);
+    TDynamicMatrix<int> expected = a * b;
+
+    TDynamicMatrix<int> cr(7);
+    TDynamicMatrix<int, TColMajor> cc(7);
+    gemm(1, a, b, 0, cc);  EXPECT_EQ(expected, TDynamicMatrix<int>(cc));
+    gemm(1, a, bc, 0, cr); EXPECT_EQ(expected, cr);
+    gemm(1, a, bc, 0, cc); EXPECT_EQ(expected, TDynamicMatrix<int>(cc));
+    gemm(1, ac, b, 0, cr); EXPECT_EQ(expected, cr);
+    gemm(1, ac, b, 0, cc); EXPECT_EQ(expected, TDynamicMatrix<int>(cc));
+    gemm(1, ac, bc, 0, cr); EXPECT_EQ(expected, cr);
+    gemm(1, ac, bc, 0, cc); EXPECT_EQ(expected, TDynamicMatrix<int>(cc));
+}
+
+/**
+ * @brief Тест: gemv и ger для матрицы, хранящейся по столбцам.
+ */
+TEST(TBlas, gemv_and_ger_on_column_major_matrix)
+{
+    TDynamicMatrix<int> a(3);
+    for (size_t i = 0; i < a.GetSize(); i++)
+        for (size_t j = 0; j < a.GetSize(); j++)
+            a[i][j] = i * 3 + j;
+    TDynamicMatrix<int, TColMajor> ac(a);
+    TDynamicVector<int> x(3);
+    x[0] = 1; x[1] = -1; x[2] = 2;
+    TDynamicVector<int> y(3);
+    TDynamicVector<int> yc(3);
+    gemv(2, a, x, 0, y);
+    gemv(2, ac, x, 0, yc);
+    EXPECT_EQ(y, yc);
+
+    ger(3, x, y, a);
+    ger(3, x, y, ac);
+    EXPECT_EQ(a, TDynamicMatrix<int>(ac));
+}
+
+// End of tests
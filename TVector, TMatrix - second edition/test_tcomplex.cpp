@@ -0,0 +1,192 @@
+﻿#include "TComplex.h"
+#include <gtest/gtest.h>
+
+// -------------------- Helpers --------------------
+
+using cd = std::complex<double>;
+
+static TDynamicVector<cd> MakeComplexVector(size_t n, int seed)
+{
+    TDynamicVector<cd> v(n);
+    for (size_t i = 0; i < n; i++)
+        v[i] = cd(double((i * 5 + seed) % 7) - 3.0, double((i * 3 + seed) % 5) - 2.0);
+    return v;
+}
+
+static TDynamicMatrix<cd> MakeComplexMatrix(size_t n, int seed)
+{
+    TDynamicMatrix<cd> m(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            m[i][j] = cd(double((i * 7 + j + seed) % 11) - 5.0, double((i + j * 3 + seed) % 7) - 3.0);
+    return m;
+}
+
+// наивное умножение через operator* из std::complex
+static TDynamicMatrix<cd> NaiveProduct(const TDynamicMatrix<cd>& a, const TDynamicMatrix<cd>& b)
+{
+    size_t n = a.GetSize();
+    TDynamicMatrix<cd> c(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            cd s = 0;
+            for (size_t k = 0; k < n; k++)
+                s += a[i][k] * b[k][j];
+            c[i][j] = s;
+        }
+    return c;
+}
+
+// -------------------- Interleaved kernel tests --------------------
+
+/**
+ * @brief Тест: операторы std::complex-векторов и матриц совпадают с наивными формулами.
+ */
+TEST(TComplex, interleaved_operators_match_naive_formulas)
+{
+    TDynamicVector<cd> x = MakeComplexVector(13, 1);
+    TDynamicVector<cd> y = MakeComplexVector(13, 2);
+    cd expected_dot = 0, expected_dotc = 0;
+    for (size_t i = 0; i < 13; i++)
+    {
+        expected_dot += x[i] * y[i];
+        expected_dotc += std::conj(x[i]) * y[i];
+    }
+    EXPECT_EQ(expected_dot, x * y);
+    EXPECT_EQ(expected_dot, dot(x, y));
+    EXPECT_EQ(expected_dotc, dotc(x, y));
+
+    TDynamicMatrix<cd> a = MakeComplexMatrix(9, 3);
+    TDynamicMatrix<cd> b = MakeComplexMatrix(9, 4);
+    EXPECT_EQ(NaiveProduct(a, b), a * b);
+}
+
+// -------------------- Split storage tests --------------------
+
+/**
+ * @brief Тест: разделение и обратная сборка не меняют вектор и матрицу.
+ */
+TEST(TComplex, split_storage_round_trips)
+{
+    TDynamicVector<cd> v = MakeComplexVector(10, 5);
+    TSplitComplexVector<double> sv(v);
+    EXPECT_EQ(v[3], sv.Get(3));
+    EXPECT_EQ(v, sv.ToInterleaved());
+
+    TDynamicMatrix<cd> m = MakeComplexMatrix(6, 6);
+    TSplitComplexMatrix<double> sm(m);
+    EXPECT_EQ(m[2][4], sm.Get(2, 4));
+    EXPECT_EQ(m, sm.ToInterleaved());
+
+    TDynamicMatrix<cd, TColMajor> mc(m);
+    EXPECT_EQ(m, TSplitComplexMatrix<double>(mc).ToInterleaved());
+}
+
+/**
+ * @brief Тест: поэлементные операции и скалярные произведения в разделённом хранении.
+ */
+TEST(TComplex, split_vector_operations_match_interleaved)
+{
+    TDynamicVector<cd> x = MakeComplexVector(17, 7);
+    TDynamicVector<cd> y = MakeComplexVector(17, 8);
+    TSplitComplexVector<double> sx(x), sy(y);
+
+    TDynamicVector<cd> sum(17), prod(17);
+    for (size_t i = 0; i < 17; i++)
+    {
+        sum[i] = x[i] + y[i];
+        prod[i] = x[i] * y[i];
+    }
+    EXPECT_EQ(sum, Add(sx, sy).ToInterleaved());
+    EXPECT_EQ(prod, MultiplyElementwise(sx, sy).ToInterleaved());
+    EXPECT_EQ(dot(x, y), Dot(sx, sy));
+    EXPECT_EQ(dotc(x, y), Dotc(sx, sy));
+    ASSERT_ANY_THROW(Add(sx, TSplitComplexVector<double>(3)));
+    ASSERT_THROW(TSplitComplexVector<double>(TDynamicVector<double>(3), TDynamicVector<double>(4)), std::invalid_argument);
+}
+
+/**
+ * @brief Тест: умножение матрицы на вектор в разделённом хранении.
+ */
+TEST(TComplex, split_gemv_matches_interleaved)
+{
+    TDynamicMatrix<cd> a = MakeComplexMatrix(11, 9);
+    TDynamicVector<cd> x = MakeComplexVector(11, 10);
+    TDynamicVector<cd> expected(11);
+    gemv(cd(1), a, x, cd(0), expected);
+
+    TSplitComplexVector<double> y = Multiply(TSplitComplexMatrix<double>(a), TSplitComplexVector<double>(x));
+    EXPECT_EQ(expected, y.ToInterleaved());
+    ASSERT_ANY_THROW(Multiply(TSplitComplexMatrix<double>(a), TSplitComplexVector<double>(4)));
+}
+
+/**
+ * @brief Тест: умножение матриц алгоритмами 4M и 3M совпадает с наивным (целые части - точно).
+ */
+TEST(TComplex, gemm_4m_and_3m_match_naive_product)
+{
+    TDynamicMatrix<cd> a = MakeComplexMatrix(12, 11);
+    TDynamicMatrix<cd> b = MakeComplexMatrix(12, 12);
+    TDynamicMatrix<cd> expected = NaiveProduct(a, b);
+    TSplitComplexMatrix<double> sa(a), sb(b);
+
+    EXPECT_EQ(expected, Multiply(sa, sb, TComplexGemm::Classic4M).ToInterleaved());
+    EXPECT_EQ(expected, Multiply(sa, sb, TComplexGemm::Gauss3M).ToInterleaved());
+    EXPECT_EQ(expected, ComplexGemm(a, b, TComplexGemm::Classic4M));
+    EXPECT_EQ(expected, ComplexGemm(a, b, TComplexGemm::Gauss3M));
+
+    TDynamicMatrix<cd, TColMajor> ac(a), bc(b);
+    TDynamicMatrix<cd, TColMajor> expected_col(expected);
+    EXPECT_EQ(expected_col, ComplexGemm(ac, bc, TComplexGemm::Gauss3M));
+    ASSERT_ANY_THROW(Multiply(sa, TSplitComplexMatrix<double>(3), TComplexGemm::Gauss3M));
+}
+
+/**
+ * @brief Тест: 3M на нецелых данных отличается от 4M только погрешностью округления.
+ */
+TEST(TComplex, gemm_3m_error_is_rounding_level)
+{
+    size_t n = 20;
+    TSplitComplexMatrix<double> a(n), b(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            a.re[i][j] = std::sin(double(i * n + j));
+            a.im[i][j] = std::cos(double(i + j * n));
+            b.re[i][j] = std::sin(double(i * 3 + j * 5) * 0.1);
+            b.im[i][j] = std::cos(double(i * 2 + j) * 0.3);
+        }
+    TSplitComplexMatrix<double> c4 = Multiply(a, b, TComplexGemm::Classic4M);
+    TSplitComplexMatrix<double> c3 = Multiply(a, b, TComplexGemm::Gauss3M);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            EXPECT_NEAR(c4.re[i][j], c3.re[i][j], 1e-12);
+            EXPECT_NEAR(c4.im[i][j], c3.im[i][j], 1e-12);
+        }
+}
+
+/**
+ * @brief Тест: ComplexGemm (Classic4M) не умножает на (1 + 0i) и сохраняет бесконечности, как operator*.
+ */
+TEST(TComplex, classic_gemm_keeps_infinities)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    TDynamicMatrix<cd> a(2), b(2);
+    a[0][0] = cd(inf, 0.0); a[0][1] = cd(1.0, 0.0);
+    a[1][1] = cd(1.0, 0.0);
+    b[0][0] = cd(1.0, 1.0); b[0][1] = cd(2.0, 1.0);
+    b[1][0] = cd(1.0, 0.0); b[1][1] = cd(3.0, 0.0);
+
+    TDynamicMatrix<cd> c = ComplexGemm(a, b, TComplexGemm::Classic4M);
+    EXPECT_EQ(cd(inf, inf), c[0][0]);
+    EXPECT_EQ(cd(inf, inf), c[0][1]);
+    EXPECT_EQ(a * b, c);
+
+    TDynamicMatrix<cd, TColMajor> ac(a), bc(b);
+    TDynamicMatrix<cd, TColMajor> cc = ComplexGemm(ac, bc, TComplexGemm::Classic4M);
+    EXPECT_EQ(cd(inf, inf), cc[0][0]);
+}
+
+// End of tests
@@ -1,5 +1,8 @@
 ﻿#include "tmatrix.h"
 #include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 
 // -------------------- Matrix tests --------------------
 
@@ -378,3 +381,325 @@ TEST(TDynamicMatrix, can_swap_matrices)
     EXPECT_EQ(m, m1_copy);
     EXPECT_EQ(m1, m_copy);
 }
+
+// -------------------- Limits and allocation tests --------------------
+
+/**
+ * @brief Тест: ограничение размера матрицы настраивается во время выполнения.
+ */
+TEST(TDynamicMatrix, max_matrix_size_is_configurable_at_runtime)
+{
+    size_t saved = GetMaxMatrixSize();
+    SetMaxMatrixSize(MAX_MATRIX_SIZE + 1);
+    ASSERT_ANY_THROW(TDynamicMatrix<int> m(MAX_MATRIX_SIZE + 2));
+    SetMaxMatrixSize(4);
+    ASSERT_ANY_THROW(TDynamicMatrix<int> m(5));
+    ASSERT_NO_THROW(TDynamicMatrix<int> m(4));
+    SetMaxMatrixSize(saved);
+}
+
+/**
+ * @brief Тест: строки, созданные параллельно, имеют нужный размер и нулевые элементы.
+ */
+TEST(TDynamicMatrix, parallel_initialized_matrix_is_zeroed)
+{
+    size_t saved = GetParallelInitThreshold();
+    SetParallelInitThreshold(0);
+    for (TAllocPolicy policy : { TAllocPolicy::FirstTouch, TAllocPolicy::Interleaved })
+    {
+        SetAllocPolicy(policy);
+        TDynamicMatrix<int> m(37);
+        bool ok = true;
+        for (size_t i = 0; i < m.GetSize(); i++)
+        {
+            ok = ok && m[i].GetSize() == m.GetSize();
+            for (size_t j = 0; j < m[i].GetSize(); j++)
+                ok = ok && m[i][j] == 0;
+        }
+        EXPECT_TRUE(ok);
+    }
+    SetAllocPolicy(TAllocPolicy::FirstTouch);
+    SetParallelInitThreshold(saved);
+}
+
+// -------------------- Matrix power tests --------------------
+
+/**
+ * @brief Тест: нулевая степень — единичная матрица.
+ */
+TEST(TDynamicMatrix, pow_zero_is_identity)
+{
+    TDynamicMatrix<int> m(3);
+    for (size_t i = 0; i < m.GetSize(); i++)
+        for (size_t j = 0; j < m.GetSize(); j++)
+            m[i][j] = i + j + 1;
+    TDynamicMatrix<int> expected(3);
+    for (size_t i = 0; i < expected.GetSize(); i++)
+        expected[i][i] = 1;
+    EXPECT_EQ(expected, m.Pow(0));
+}
+
+/**
+ * @brief Тест: степень совпадает с последовательными умножениями.
+ */
+TEST(TDynamicMatrix, pow_matches_repeated_multiplication)
+{
+    TDynamicMatrix<long long> m(3);
+    for (size_t i = 0; i < m.GetSize(); i++)
+        for (size_t j = 0; j < m.GetSize(); j++)
+            m[i][j] = (i * 3 + j) % 4 - 1;
+    TDynamicMatrix<long long> expected = m;
+    for (int p = 2; p <= 7; p++)
+        expected = expected * m;
+    EXPECT_EQ(expected, m.Pow(7));
+}
+
+/**
+ * @brief Тест: число Фибоначчи F(10^18) по модулю 10^9 + 7.
+ */
+TEST(TDynamicMatrix, pow_mod_computes_huge_fibonacci)
+{
+    TDynamicMatrix<long long> m(2);
+    m[0][0] = 1; m[0][1] = 1;
+    m[1][0] = 1; m[1][1] = 0;
+    TDynamicMatrix<long long> r = m.Pow(1000000000000000000ULL, 1000000007LL);
+    EXPECT_EQ(209783453LL, r[0][1]);
+}
+
+/**
+ * @brief Тест: модуль больше 2^32 не вызывает переполнения.
+ */
+TEST(TDynamicMatrix, pow_mod_handles_modulus_above_32_bits)
+{
+    TDynamicMatrix<long long> m(2);
+    m[0][0] = 1; m[0][1] = 1;
+    m[1][0] = 1; m[1][1] = 0;
+    TDynamicMatrix<long long> r = m.Pow(1000000000000000000ULL, (1LL << 61) - 1);
+    EXPECT_EQ(1024960830501646393LL, r[0][1]);
+}
+
+/**
+ * @brief Тест: неположительный модуль должен бросать.
+ */
+TEST(TDynamicMatrix, pow_mod_throws_on_non_positive_modulus)
+{
+    TDynamicMatrix<int> m(2);
+    ASSERT_ANY_THROW(m.Pow(3, 0));
+}
+
+// -------------------- Approximate comparison tests --------------------
+
+/**
+ * @brief Тест: сравнение матриц с допуском.
+ */
+TEST(TDynamicMatrix, equals_approx_respects_tolerance)
+{
+    TDynamicMatrix<double> m(20);
+    for (size_t i = 0; i < m.GetSize(); i++)
+        for (size_t j = 0; j < m.GetSize(); j++)
+            m[i][j] = i * 0.25 + j;
+    TDynamicMatrix<double> m1 = m;
+    m1[19][19] += 1e-10;
+    EXPECT_NE(m, m1);
+    EXPECT_TRUE(m.EqualsApprox(m1, 1e-8));
+    m1[5][7] -= 1.0;
+    EXPECT_FALSE(m.EqualsApprox(m1, 1e-8));
+}
+
+// -------------------- Layout tests --------------------
+
+/**
+ * @brief Вспомогательная функция: заполнение матрицы любой раскладки по формуле.
+ */
+template<typename L>
+static TDynamicMatrix<int, L> make_layout_test_matrix(size_t n, int seed)
+{
+    TDynamicMatrix<int, L> m(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            m[i][j] = static_cast<int>((i * 7 + j * 3 + seed) % 11) - 5;
+    return m;
+}
+
+/**
+ * @brief Тест: m[i][j] означает строку i и столбец j при хранении по столбцам.
+ */
+TEST(TDynamicMatrix, column_major_indexing_is_row_then_column)
+{
+    TDynamicMatrix<int, TColMajor> m(3);
+    m[0][2] = 5;
+    EXPECT_EQ(5, m.Line(2)[0]);
+    EXPECT_EQ(3u, m[1].GetSize());
+}
+
+/**
+ * @brief Тест: преобразование раскладки сохраняет элементы.
+ */
+TEST(TDynamicMatrix, layout_conversion_preserves_elements)
+{
+    TDynamicMatrix<int> m = make_layout_test_matrix<TRowMajor>(37, 1);
+    TDynamicMatrix<int, TColMajor> c(m);
+    TDynamicMatrix<int> back(c);
+    EXPECT_EQ(m, back);
+    EXPECT_EQ(m[5][30], c[5][30]);
+}
+
+/**
+ * @brief Тест: умножение при всех сочетаниях раскладок совпадает с построчным.
+ */
+TEST(TDynamicMatrix, multiply_matches_for_all_layout_combinations)
+{
+    TDynamicMatrix<int> a = make_layout_test_matrix<TRowMajor>(9, 1);
+    TDynamicMatrix<int> b = make_layout_test_matrix<TRowMajor>(9, 4);
+    TDynamicMatrix<int, TColMajor> ac(a);
+    TDynamicMatrix<int, TColMajor> bc(b);
+    TDynamicMatrix<int> expected = a * b;
+    EXPECT_EQ(expected, a * bc);
+    EXPECT_EQ(expected, TDynamicMatrix<int>(ac * b));
+    EXPECT_EQ(expected, TDynamicMatrix<int>(ac * bc));
+}
+
+/**
+ * @brief Тест: сложение и вычитание матриц разной раскладки.
+ */
+TEST(TDynamicMatrix, add_and_subtract_mixed_layouts)
+{
+    TDynamicMatrix<int> a = make_layout_test_matrix<TRowMajor>(40, 2);
+    TDynamicMatrix<int> b = make_layout_test_matrix<TRowMajor>(40, 5);
+    TDynamicMatrix<int, TColMajor> bc(b);
+    EXPECT_EQ(a + b, a + bc);
+    EXPECT_EQ(a - b, a - bc);
+}
+
+/**
+ * @brief Тест: умножение на вектор и возведение в степень при хранении по столбцам.
+ */
+TEST(TDynamicMatrix, column_major_matrix_vector_and_pow)
+{
+    TDynamicMatrix<int> a = make_layout_test_matrix<TRowMajor>(6, 3);
+    TDynamicMatrix<int, TColMajor> ac(a);
+    TDynamicVector<int> v(6);
+    for (size_t i = 0; i < v.GetSize(); i++)
+        v[i] = i * 2 - 3;
+    EXPECT_EQ(a * v, ac * v);
+    EXPECT_EQ(a.Pow(5), TDynamicMatrix<int>(ac.Pow(5)));
+    EXPECT_EQ(a.Pow(9, 101), TDynamicMatrix<int>(ac.Pow(9, 101)));
+}
+
+/**
+ * @brief Тест: воспроизводимые произведения побитово одинаковы при любом числе потоков и раскладке.
+ */
+TEST(TDynamicMatrix, reproducible_products_are_identical_across_threads_and_layouts)
+{
+    size_t saved = GetAutoParallelThreshold();
+    const size_t n = 300;
+    TDynamicMatrix<double> a(n);
+    TDynamicMatrix<double> b(n);
+    TDynamicVector<double> x(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        x[i] = 1.0 / (i + 3);
+        for (size_t j = 0; j < n; j++)
+        {
+            a[i][j] = (double((i * 7 + j) % 11) - 5.0) * ((j % 2) ? 1e6 : 1e-6);
+            b[i][j] = 1.0 / (i + j + 1);
+        }
+    }
+    TDynamicMatrix<double, TColMajor> ac(a);
+    TDynamicMatrix<double, TColMajor> bc(b);
+
+    SetAutoParallelThreshold(size_t(-1));
+    TDynamicVector<double> y = MultiplyReproducible(a, x);
+    TDynamicMatrix<double> c = MultiplyReproducible(a, b);
+
+    SetAutoParallelThreshold(0);
+    for (size_t threads : { 1, 3, 8 })
+    {
+        SetParallelThreads(threads);
+        EXPECT_EQ(y, MultiplyReproducible(a, x));
+        EXPECT_EQ(y, MultiplyReproducible(ac, x));
+        EXPECT_EQ(c, MultiplyReproducible(a, bc));
+        EXPECT_EQ(c, TDynamicMatrix<double>(MultiplyReproducible(ac, b)));
+    }
+
+    SetReproducibleReductions(true);
+    EXPECT_EQ(y, ac * x);
+    EXPECT_EQ(c, a * bc);
+    SetReproducibleReductions(false);
+
+    SetParallelThreads(0);
+    SetAutoParallelThreshold(saved);
+    EXPECT_TRUE(c.EqualsApprox(a * b, 1e-3));
+}
+
+/**
+ * @brief Тест: произведения без множителя не умножают на (1 + 0i), бесконечности в комплексных элементах не превращаются в NaN.
+ */
+TEST(TDynamicMatrix, complex_products_keep_infinities)
+{
+    using C = std::complex<double>;
+    const double inf = std::numeric_limits<double>::infinity();
+    TDynamicMatrix<C> a(2), b(2);
+    a[0][0] = C(inf, 0.0); a[0][1] = C(1.0, 0.0);
+    a[1][0] = C(0.0, 0.0); a[1][1] = C(1.0, 0.0);
+    b[0][0] = C(1.0, 1.0); b[0][1] = C(2.0, 1.0);
+    b[1][0] = C(1.0, 0.0); b[1][1] = C(3.0, 0.0);
+    TDynamicVector<C> v(2);
+    v[0] = C(1.0, 1.0);
+    v[1] = C(1.0, 0.0);
+
+    TDynamicMatrix<C> c = a * b;
+    const C infinite(inf, inf);
+    EXPECT_EQ(infinite, c[0][0]);
+    EXPECT_EQ(infinite, c[0][1]);
+    EXPECT_EQ(C(1.0, 0.0), c[1][0]);
+    EXPECT_EQ(C(3.0, 0.0), c[1][1]);
+
+    TDynamicMatrix<C, TColMajor> ac(a), bc(b);
+    TDynamicMatrix<C, TColMajor> cc = ac * bc;
+    EXPECT_EQ(infinite, cc[0][0]);
+    EXPECT_EQ(C(3.0, 0.0), cc[1][1]);
+
+    TDynamicVector<C> y = a * v;
+    EXPECT_EQ(infinite, y[0]);
+    EXPECT_EQ(C(1.0, 0.0), y[1]);
+    TDynamicVector<C> yc = ac * v;
+    EXPECT_EQ(infinite, yc[0]);
+}
+
+/**
+ * @brief Тест: воспроизводимые суммы дают фиксированный набор бит - произведения округляются до сложения (без FMA).
+ */
+TEST(TDynamicMatrix, reproducible_sums_match_fixed_bit_pattern)
+{
+    // (1 + 2^-30)(1 - 2^-30) = 1 - 2^-60 округляется до 1, так что каждая частичная
+    // сумма -1 + 1 равна нулю; с FMA она была бы -2^-60, а сумма - -2^-57
+    const size_t n = 16;
+    const double eps = std::ldexp(1.0, -30);
+    TDynamicMatrix<double> a(n), b(n);
+    TDynamicVector<double> x(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t k = 0; k < n; k++)
+        {
+            a[i][k] = (k < 8) ? -1.0 : 1.0 + eps;
+            b[k][i] = (k < 8) ? 1.0 : 1.0 - eps;
+            x[k] = b[k][i];
+        }
+
+    auto bits = [](double v)
+    {
+        std::uint64_t u;
+        std::memcpy(&u, &v, sizeof(u));
+        return u;
+    };
+    const std::uint64_t zero = 0x0000000000000000ull;
+    EXPECT_EQ(zero, bits(Dot(policy::reproducible, a[3], x)));
+    TDynamicVector<double> y = MultiplyReproducible(a, x);
+    TDynamicMatrix<double> c = MultiplyReproducible(a, b);
+    for (size_t i = 0; i < n; i++)
+    {
+        EXPECT_EQ(zero, bits(y[i]));
+        for (size_t j = 0; j < n; j++)
+            EXPECT_EQ(zero, bits(c[i][j]));
+    }
+}
@@ -0,0 +1,167 @@
+﻿#include "TOutOfCore.h"
+#include <gtest/gtest.h>
+
+// -------------------- Helpers --------------------
+
+// временный файл, удаляемый в конце теста
+struct TTempPath
+{
+    std::string path;
+
+    explicit TTempPath(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / ("tdiskmatrix_" + name + ".bin")).string()) {}
+    ~TTempPath() { std::error_code ec; std::filesystem::remove(path, ec); }
+};
+
+static TDynamicMatrix<long long> MakeMatrix(size_t n, long long seed)
+{
+    TDynamicMatrix<long long> m(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            m[i][j] = (long long)((i * 7 + j * 3 + seed) % 11) - 5;
+    return m;
+}
+
+// -------------------- TDiskMatrix tests --------------------
+
+/**
+ * @brief Тест: матрица, записанная на диск, читается обратно без изменений (размер не кратен плитке).
+ */
+TEST(TOutOfCore, disk_matrix_round_trips_through_file)
+{
+    TTempPath file("roundtrip");
+    TDynamicMatrix<long long> m = MakeMatrix(10, 1);
+    TDiskMatrix<long long> d(file.path, m, 4);
+    EXPECT_EQ(10u, d.GetSize());
+    EXPECT_EQ(3u, d.GetTileCount());
+    EXPECT_EQ(m, d.ToMatrix());
+}
+
+/**
+ * @brief Тест: существующий файл открывается повторно с теми же параметрами.
+ */
+TEST(TOutOfCore, disk_matrix_reopens_existing_file)
+{
+    TTempPath file("reopen");
+    TDynamicMatrix<long long> m = MakeMatrix(9, 2);
+    {
+        TDiskMatrix<long long> d(file.path, m, 5);
+    }
+    TDiskMatrix<long long> reopened(file.path);
+    EXPECT_EQ(9u, reopened.GetSize());
+    EXPECT_EQ(5u, reopened.GetTileSize());
+    EXPECT_EQ(m, reopened.ToMatrix());
+    ASSERT_ANY_THROW(TDiskMatrix<int> wrong(file.path));
+}
+
+/**
+ * @brief Тест: новая матрица на диске заполнена нулями.
+ */
+TEST(TOutOfCore, new_disk_matrix_is_zero)
+{
+    TTempPath file("zero");
+    TDiskMatrix<long long> d(file.path, 7, 3);
+    EXPECT_EQ(TDynamicMatrix<long long>(7), d.ToMatrix());
+}
+
+/**
+ * @brief Тест: индекс плитки вне матрицы и неверный размер буфера должны бросать.
+ */
+TEST(TOutOfCore, tile_access_throws_on_bad_index_or_size)
+{
+    TTempPath file("tiles");
+    TDiskMatrix<long long> d(file.path, 6, 3);
+    TDynamicMatrix<long long> buf(3);
+    TDynamicMatrix<long long> wrong(4);
+    ASSERT_ANY_THROW(d.ReadTile(2, 0, buf));
+    ASSERT_ANY_THROW(d.ReadTile(0, 0, wrong));
+    ASSERT_ANY_THROW(d.WriteTile(0, 2, buf));
+}
+
+// -------------------- Operation tests --------------------
+
+/**
+ * @brief Тест: внешнее умножение совпадает с умножением в памяти при любом бюджете.
+ */
+TEST(TOutOfCore, multiply_matches_in_memory_product)
+{
+    TTempPath fa("mul_a"), fb("mul_b"), fc("mul_c");
+    TDynamicMatrix<long long> a = MakeMatrix(11, 3);
+    TDynamicMatrix<long long> b = MakeMatrix(11, 4);
+    TDynamicMatrix<long long> expected = a * b;
+
+    TDiskMatrix<long long> da(fa.path, a, 4);
+    TDiskMatrix<long long> db(fb.path, b, 4);
+    TDiskMatrix<long long> dc(fc.path, 11, 4);
+    const size_t tile_bytes = 4 * 4 * sizeof(long long);
+
+    // панель из одной плитки C
+    TOutOfCoreOptions tight;
+    tight.memory_budget = 5 * tile_bytes;
+    OutOfCoreMultiply(da, db, dc, tight);
+    EXPECT_EQ(expected, dc.ToMatrix());
+
+    // вся строка плиток C в памяти
+    TOutOfCoreOptions wide;
+    wide.memory_budget = 64 * tile_bytes;
+    OutOfCoreMultiply(da, db, dc, wide);
+    EXPECT_EQ(expected, dc.ToMatrix());
+}
+
+/**
+ * @brief Тест: внешнее сложение совпадает со сложением в памяти, в том числе на месте.
+ */
+TEST(TOutOfCore, add_matches_in_memory_sum)
+{
+    TTempPath fa("add_a"), fb("add_b"), fc("add_c");
+    TDynamicMatrix<long long> a = MakeMatrix(10, 5);
+    TDynamicMatrix<long long> b = MakeMatrix(10, 6);
+    TDynamicMatrix<long long> expected = a + b;
+
+    TDiskMatrix<long long> da(fa.path, a, 3);
+    TDiskMatrix<long long> db(fb.path, b, 3);
+    TDiskMatrix<long long> dc(fc.path, 10, 3);
+    OutOfCoreAdd(da, db, dc);
+    EXPECT_EQ(expected, dc.ToMatrix());
+
+    OutOfCoreAdd(da, db, da);
+    EXPECT_EQ(expected, da.ToMatrix());
+}
+
+/**
+ * @brief Тест: внешнее умножение на вектор совпадает с умножением в памяти.
+ */
+TEST(TOutOfCore, gemv_matches_in_memory_product)
+{
+    TTempPath fa("gemv");
+    TDynamicMatrix<long long> a = MakeMatrix(13, 7);
+    TDynamicVector<long long> x(13);
+    for (size_t i = 0; i < 13; i++)
+        x[i] = (long long)i - 6;
+    TDynamicVector<long long> expected = a * x;
+
+    TDiskMatrix<long long> da(fa.path, a, 5);
+    TDynamicVector<long long> y(13);
+    OutOfCoreGemv(da, x, y);
+    EXPECT_EQ(expected, y);
+}
+
+/**
+ * @brief Тест: слишком малый бюджет памяти и совпадение результата с операндом должны бросать.
+ */
+TEST(TOutOfCore, multiply_throws_on_small_budget_or_alias)
+{
+    TTempPath fa("throw_a"), fb("throw_b");
+    TDiskMatrix<long long> da(fa.path, 8, 4);
+    TDiskMatrix<long long> db(fb.path, 8, 4);
+
+    TOutOfCoreOptions small;
+    small.memory_budget = 4 * 4 * 4 * sizeof(long long);
+    TDiskMatrix<long long>& alias = da;
+    ASSERT_ANY_THROW(OutOfCoreMultiply(da, db, alias));
+    TTempPath fc("throw_c");
+    TDiskMatrix<long long> dc(fc.path, 8, 4);
+    ASSERT_ANY_THROW(OutOfCoreMultiply(da, db, dc, small));
+}
+
+// End of tests
@@ -0,0 +1,179 @@
+﻿#include "TParallel.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// -------------------- Parallel tests --------------------
+
+/**
+ * @brief Тест: блоки разбиения покрывают диапазон без пропусков и пересечений.
+ */
+TEST(TParallel, chunks_cover_range_exactly)
+{
+    const size_t count = 103;
+    const size_t chunks = 7;
+    EXPECT_EQ(0u, ChunkBegin(count, chunks, 0));
+    EXPECT_EQ(count, ChunkBegin(count, chunks, chunks));
+    for (size_t c = 0; c < chunks; c++)
+    {
+        size_t len = ChunkBegin(count, chunks, c + 1) - ChunkBegin(count, chunks, c);
+        EXPECT_TRUE(len == count / chunks || len == count / chunks + 1);
+    }
+}
+
+/**
+ * @brief Тест: ParallelFor обрабатывает каждый элемент ровно один раз.
+ */
+TEST(TParallel, parallel_for_visits_every_element_once)
+{
+    SetParallelThreads(4);
+    std::vector<int> visits(1000, 0);
+    ParallelFor(visits.size(), [&](size_t begin, size_t end, size_t)
+    {
+        for (size_t i = begin; i < end; i++)
+            visits[i]++;
+    });
+    for (size_t i = 0; i < visits.size(); i++)
+        EXPECT_EQ(1, visits[i]);
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief Тест: вложенный ParallelFor выполняется последовательно одним блоком.
+ */
+TEST(TParallel, nested_parallel_for_runs_serially)
+{
+    SetParallelThreads(4);
+    std::atomic<int> nested_chunks{ 0 };
+    ParallelFor(8, [&](size_t, size_t, size_t)
+    {
+        EXPECT_TRUE(InParallelRegion());
+        ParallelFor(100, [&](size_t begin, size_t end, size_t)
+        {
+            EXPECT_EQ(0u, begin);
+            EXPECT_EQ(100u, end);
+            nested_chunks++;
+        });
+    });
+    EXPECT_EQ(4, nested_chunks.load());
+    EXPECT_FALSE(InParallelRegion());
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief Тест: исключение из тела цикла пробрасывается вызывающему.
+ */
+TEST(TParallel, parallel_for_rethrows_exceptions)
+{
+    SetParallelThreads(4);
+    ASSERT_THROW(ParallelFor(100, [](size_t begin, size_t, size_t)
+    {
+        if (begin > 0)
+            throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief Тест: блок c при каждом вызове выполняет один и тот же постоянный поток, блок 0 - вызывающий.
+ */
+TEST(TParallel, chunks_run_on_the_same_persistent_workers)
+{
+    SetParallelThreads(4);
+    std::vector<std::thread::id> first(4), second(4);
+    ParallelFor(400, [&](size_t, size_t, size_t c) { first[c] = std::this_thread::get_id(); });
+    ParallelFor(400, [&](size_t, size_t, size_t c) { second[c] = std::this_thread::get_id(); });
+    ParallelFor(2, [&](size_t, size_t, size_t c) { second[c] = std::this_thread::get_id(); });
+    EXPECT_EQ(std::this_thread::get_id(), first[0]);
+    for (size_t c = 0; c < 4; c++)
+        EXPECT_EQ(first[c], second[c]);
+    for (size_t c = 1; c < 4; c++)
+        EXPECT_NE(first[0], first[c]);
+
+    // одновременные вызовы из разных потоков обрабатывают все элементы
+    std::atomic<int> total{ 0 };
+    std::thread other([&]()
+    {
+        for (int k = 0; k < 50; k++)
+            ParallelFor(8, [&](size_t begin, size_t end, size_t) { total += int(end - begin); });
+    });
+    for (int k = 0; k < 50; k++)
+        ParallelFor(8, [&](size_t begin, size_t end, size_t) { total += int(end - begin); });
+    other.join();
+    EXPECT_EQ(800, total.load());
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief Тест: вызов из другого потока не ждёт, пока пул занят, а выполняет блоки сам.
+ */
+TEST(TParallel, independent_callers_do_not_wait_for_busy_pool)
+{
+    SetParallelThreads(4);
+    std::promise<void> other_done;
+    std::future<void> done = other_done.get_future();
+    std::thread other;
+    std::vector<std::thread::id> other_chunks(4);
+    bool finished_while_busy = false;
+
+    ParallelFor(400, [&](size_t, size_t, size_t c)
+    {
+        if (c != 0)
+            return;
+        // пул занят этим вызовом, пока блок 0 ждёт другой поток
+        other = std::thread([&]()
+        {
+            ParallelFor(400, [&](size_t, size_t, size_t oc) { other_chunks[oc] = std::this_thread::get_id(); });
+            other_done.set_value();
+        });
+        finished_while_busy = done.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+    });
+    other.join();
+
+    EXPECT_TRUE(finished_while_busy);
+    for (size_t c = 1; c < 4; c++)
+        EXPECT_EQ(other_chunks[0], other_chunks[c]);
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief Тест: RunsParallel выбирает исполнение по политике и порогу.
+ */
+TEST(TParallel, runs_parallel_follows_policy_and_threshold)
+{
+    EXPECT_FALSE(RunsParallel<policy::TSequenced>(1u << 30, 8));
+    EXPECT_TRUE(RunsParallel<policy::TParallel>(10, 8));
+    EXPECT_TRUE(RunsParallel<policy::TParallelUnsequenced>(10, 8));
+
+    size_t saved = GetAutoParallelThreshold();
+    SetAutoParallelThreshold(800);
+    EXPECT_FALSE(RunsParallel<policy::TAutomatic>(99, 8));
+    EXPECT_TRUE(RunsParallel<policy::TAutomatic>(100, 8));
+    SetAutoParallelThreshold(saved);
+}
+
+/**
+ * @brief Тест: ForChunks с policy::seq вызывает тело один раз, с policy::par — по блокам.
+ */
+TEST(TParallel, for_chunks_splits_only_for_parallel_policies)
+{
+    SetParallelThreads(4);
+    std::atomic<int> calls{ 0 };
+    ForChunks<policy::TSequenced>(1000, 8, [&](size_t begin, size_t end, size_t)
+    {
+        EXPECT_EQ(0u, begin);
+        EXPECT_EQ(1000u, end);
+        calls++;
+    });
+    EXPECT_EQ(1, calls.load());
+
+    calls = 0;
+    ForChunks<policy::TParallel>(1000, 8, [&](size_t, size_t, size_t) { calls++; });
+    EXPECT_EQ(4, calls.load());
+    SetParallelThreads(0);
+}
+
+// End of tests
@@ -0,0 +1,190 @@
+﻿#include "TSemiring.h"
+#include <gtest/gtest.h>
+
+// -------------------- Helpers --------------------
+
+static const double INF = std::numeric_limits<double>::infinity();
+
+// наивное произведение над полукольцом S (тройной цикл)
+template<typename S, typename L>
+static TDynamicMatrix<typename S::value_type, L> NaiveSemiringProduct(const TDynamicMatrix<typename S::value_type, L>& a,
+    const TDynamicMatrix<typename S::value_type, L>& b)
+{
+    size_t n = a.GetSize();
+    TDynamicMatrix<typename S::value_type, L> c(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            typename S::value_type s = S::Zero();
+            for (size_t k = 0; k < n; k++)
+                s = S::Add(s, S::Mul(a[i][k], b[k][j]));
+            c[i][j] = s;
+        }
+    return c;
+}
+
+// разреженная матрица весов: часть рёбер отсутствует (Zero)
+template<typename S, typename L = TRowMajor>
+static TDynamicMatrix<typename S::value_type, L> MakeWeights(size_t n, size_t seed)
+{
+    TDynamicMatrix<typename S::value_type, L> m(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            size_t h = (i * 31 + j * 17 + seed) % 13;
+            m[i][j] = (h < 5) ? S::Zero() : typename S::value_type(h % 7) - typename S::value_type(2);
+        }
+    return m;
+}
+
+// Флойд-Уоршелл для сравнения с замыканием
+static TDynamicMatrix<double> FloydWarshall(TDynamicMatrix<double> d)
+{
+    size_t n = d.GetSize();
+    for (size_t i = 0; i < n; i++)
+        d[i][i] = std::min(d[i][i], 0.0);
+    for (size_t k = 0; k < n; k++)
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++)
+                d[i][j] = std::min(d[i][j], d[i][k] + d[k][j]);
+    return d;
+}
+
+// -------------------- Product tests --------------------
+
+/**
+ * @brief Тест: min-plus и max-plus произведения совпадают с наивным тройным циклом при любой раскладке.
+ */
+TEST(TSemiring, min_plus_and_max_plus_match_naive_product)
+{
+    using MinPlus = TMinPlusSemiring<double>;
+    using MaxPlus = TMaxPlusSemiring<double>;
+    TDynamicMatrix<double> a = MakeWeights<MinPlus>(70, 1);
+    TDynamicMatrix<double> b = MakeWeights<MinPlus>(70, 2);
+    EXPECT_EQ(NaiveSemiringProduct<MinPlus>(a, b), SemiringMultiply<MinPlus>(a, b));
+
+    TDynamicMatrix<double, TColMajor> ac = MakeWeights<MinPlus, TColMajor>(70, 1);
+    TDynamicMatrix<double, TColMajor> bc = MakeWeights<MinPlus, TColMajor>(70, 2);
+    EXPECT_EQ(NaiveSemiringProduct<MinPlus>(ac, bc), SemiringMultiply<MinPlus>(ac, bc));
+
+    TDynamicMatrix<double> x = MakeWeights<MaxPlus>(70, 3);
+    TDynamicMatrix<double> y = MakeWeights<MaxPlus>(70, 4);
+    EXPECT_EQ(NaiveSemiringProduct<MaxPlus>(x, y), SemiringMultiply<MaxPlus>(x, y));
+}
+
+/**
+ * @brief Тест: для целых типов отсутствие ребра (максимум) не переполняется при сложении.
+ */
+TEST(TSemiring, integer_min_plus_saturates_at_zero_element)
+{
+    using MinPlus = TMinPlusSemiring<int>;
+    TDynamicMatrix<int> a = MakeWeights<MinPlus>(9, 5);
+    TDynamicMatrix<int> b = MakeWeights<MinPlus>(9, 6);
+    a[0][0] = MinPlus::Zero();
+    b[0][0] = MinPlus::Zero();
+    TDynamicMatrix<int> c = SemiringMultiply<MinPlus>(a, b);
+    EXPECT_EQ(NaiveSemiringProduct<MinPlus>(a, b), c);
+    for (size_t i = 0; i < 9; i++)
+        for (size_t j = 0; j < 9; j++)
+            EXPECT_TRUE(c[i][j] == MinPlus::Zero() || c[i][j] < 100);
+
+    // конечные веса у границы типа: сумма насыщается, а не переполняется
+    const int big = 2000000000;
+    EXPECT_EQ(MinPlus::Zero(), MinPlus::Mul(big, big));
+    EXPECT_EQ(std::numeric_limits<int>::lowest(), MinPlus::Mul(-big, -big));
+    EXPECT_EQ(big - 1, MinPlus::Mul(big, -1));
+    TDynamicMatrix<int> x(2), y(2);
+    x[0][0] = big;  x[0][1] = 1;
+    x[1][0] = MinPlus::Zero();  x[1][1] = big;
+    y[0][0] = big;  y[0][1] = big;
+    y[1][0] = 5;  y[1][1] = MinPlus::Zero();
+    TDynamicMatrix<int> z = SemiringMultiply<MinPlus>(x, y);
+    EXPECT_EQ(6, z[0][0]);
+    EXPECT_EQ(MinPlus::Zero(), z[0][1]);
+    EXPECT_EQ(big + 5, z[1][0]);
+    EXPECT_EQ(MinPlus::Zero(), z[1][1]);
+
+    using MaxPlus = TMaxPlusSemiring<int>;
+    EXPECT_EQ(MaxPlus::Zero(), MaxPlus::Mul(-big, -big));
+    EXPECT_EQ(std::numeric_limits<int>::max(), MaxPlus::Mul(big, big));
+    EXPECT_EQ(MaxPlus::Zero(), MaxPlus::Mul(MaxPlus::Zero(), big));
+    using UnsignedMinPlus = TMinPlusSemiring<unsigned>;
+    EXPECT_EQ(UnsignedMinPlus::Zero(), UnsignedMinPlus::Mul(4000000000u, 4000000000u));
+}
+
+/**
+ * @brief Тест: упакованное булево произведение совпадает с наивным (размер не кратен 64).
+ */
+TEST(TSemiring, boolean_product_matches_naive_product)
+{
+    size_t n = 131;
+    TDynamicMatrix<bool> a(n), b(n);
+    TDynamicMatrix<bool, TColMajor> ac(n), bc(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            a[i][j] = ac[i][j] = (i * 7 + j * 3) % 29 == 0;
+            b[i][j] = bc[i][j] = (i * 5 + j * 11) % 23 == 0;
+        }
+    EXPECT_EQ(NaiveSemiringProduct<TBooleanSemiring>(a, b), SemiringMultiply<TBooleanSemiring>(a, b));
+    EXPECT_EQ(NaiveSemiringProduct<TBooleanSemiring>(ac, bc), SemiringMultiply<TBooleanSemiring>(ac, bc));
+}
+
+/**
+ * @brief Тест: арифметическое полукольцо совпадает с operator*; разные размеры бросают.
+ */
+TEST(TSemiring, arithmetic_semiring_matches_operator_multiply)
+{
+    TDynamicMatrix<long long> a(12), b(12);
+    for (size_t i = 0; i < 12; i++)
+        for (size_t j = 0; j < 12; j++)
+        {
+            a[i][j] = (long long)((i * 3 + j) % 7) - 3;
+            b[i][j] = (long long)((i + j * 5) % 9) - 4;
+        }
+    EXPECT_EQ(a * b, SemiringMultiply<TArithmeticSemiring<long long>>(a, b));
+    ASSERT_ANY_THROW(SemiringMultiply<TArithmeticSemiring<long long>>(a, TDynamicMatrix<long long>(3)));
+}
+
+// -------------------- Closure tests --------------------
+
+/**
+ * @brief Тест: min-plus замыкание совпадает с Флойдом-Уоршеллом (с отрицательными рёбрами без отрицательных циклов).
+ */
+TEST(TSemiring, min_plus_closure_matches_floyd_warshall)
+{
+    size_t n = 40;
+    TDynamicMatrix<double> w(n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+        {
+            if (j == i + 1)
+                w[i][j] = -1.0;                           // цепочка с отрицательными весами
+            else if ((i * 13 + j * 7) % 11 == 0)
+                w[i][j] = double((i + j) % 5) + 2.0 + double(i > j ? i - j : 0);
+            else
+                w[i][j] = INF;
+        }
+    EXPECT_EQ(FloydWarshall(w), SemiringClosure<TMinPlusSemiring<double>>(w));
+
+    TDynamicMatrix<double, TColMajor> wc(w);
+    TDynamicMatrix<double, TColMajor> expected_col(FloydWarshall(w));
+    EXPECT_EQ(expected_col, SemiringClosure<TMinPlusSemiring<double>>(wc));
+}
+
+/**
+ * @brief Тест: булево замыкание цепочки даёт достижимость вперёд, включая саму вершину.
+ */
+TEST(TSemiring, boolean_closure_is_reachability)
+{
+    size_t n = 70;
+    TDynamicMatrix<bool> g(n);
+    for (size_t i = 0; i + 1 < n; i++)
+        g[i][i + 1] = true;
+    TDynamicMatrix<bool> r = SemiringClosure<TBooleanSemiring>(g);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            EXPECT_EQ(i <= j, r[i][j]);
+}
+
+// End of tests
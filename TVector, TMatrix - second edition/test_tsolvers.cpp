@@ -0,0 +1,326 @@
+﻿#include "TSolvers.h"
+#include <gtest/gtest.h>
+
+// -------------------- Helpers --------------------
+
+// трёхдиагональная SPD-матрица (4 на диагонали, -1 рядом)
+static TDynamicMatrix<double> MakeSpd(size_t n)
+{
+    TDynamicMatrix<double> a(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i][i] = 4.0;
+        if (i > 0) a[i][i - 1] = -1.0;
+        if (i + 1 < n) a[i][i + 1] = -1.0;
+    }
+    return a;
+}
+
+// несимметричная матрица с диагональным преобладанием
+static TDynamicMatrix<double> MakeNonsymmetric(size_t n)
+{
+    TDynamicMatrix<double> a(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i][i] = 5.0;
+        if (i > 0) a[i][i - 1] = -2.0;
+        if (i + 1 < n) a[i][i + 1] = 1.0;
+        if (i + 3 < n) a[i][i + 3] = 0.5;
+    }
+    return a;
+}
+
+// правая часть для решения x[i] = i + 1
+template<typename L>
+static TDynamicVector<double> MakeRhs(const TDynamicMatrix<double, L>& a)
+{
+    size_t n = a.GetSize();
+    TDynamicVector<double> expected(n);
+    for (size_t i = 0; i < n; i++)
+        expected[i] = double(i + 1);
+    TDynamicVector<double> b(n);
+    gemv(1.0, a, expected, 0.0, b);
+    return b;
+}
+
+static void ExpectSolution(const TDynamicVector<double>& x)
+{
+    for (size_t i = 0; i < x.GetSize(); i++)
+        EXPECT_NEAR(double(i + 1), x[i], 1e-6);
+}
+
+// оператор без хранимой матрицы: тот же трёхдиагональный оператор
+struct TTridiagonalOperator
+{
+    size_t n;
+
+    size_t GetSize() const { return n; }
+
+    void Apply(const TDynamicVector<double>& x, TDynamicVector<double>& y) const
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            double sum = 4.0 * x[i];
+            if (i > 0) sum -= x[i - 1];
+            if (i + 1 < n) sum -= x[i + 1];
+            y[i] = sum;
+        }
+    }
+};
+
+// -------------------- Krylov tests --------------------
+
+/**
+ * @brief Тест: CG решает SPD-систему.
+ */
+TEST(TSolvers, conjugate_gradient_solves_spd_system)
+{
+    TDynamicMatrix<double> a = MakeSpd(20);
+    TDynamicVector<double> b = MakeRhs(a);
+    TDynamicVector<double> x(20);
+    TSolverWorkspace<double> ws(20);
+    TSolverResult<double> res = ConjugateGradient(a, b, x, ws);
+    EXPECT_TRUE(res.converged);
+    EXPECT_LE(res.iterations, 20u);
+    ExpectSolution(x);
+}
+
+/**
+ * @brief Тест: CG с предобусловливателями Якоби и ILU(0) сходится не медленнее.
+ */
+TEST(TSolvers, preconditioned_conjugate_gradient_converges)
+{
+    TDynamicMatrix<double> a = MakeSpd(30);
+    TDynamicVector<double> b = MakeRhs(a);
+    TSolverWorkspace<double> ws(30);
+
+    TDynamicVector<double> x0(30);
+    TSolverResult<double> plain = ConjugateGradient(a, b, x0, ws);
+
+    TDynamicVector<double> x1(30);
+    TSolverResult<double> jac = ConjugateGradient(a, b, x1, ws, {}, TJacobiPreconditioner<double>(a));
+    EXPECT_TRUE(jac.converged);
+    ExpectSolution(x1);
+
+    // для трёхдиагональной матрицы ILU(0) совпадает с точным LU
+    TDynamicVector<double> x2(30);
+    TSolverResult<double> ilu = ConjugateGradient(a, b, x2, ws, {}, TILU0Preconditioner<double>(a));
+    EXPECT_TRUE(ilu.converged);
+    EXPECT_LE(ilu.iterations, 2u);
+    EXPECT_LE(ilu.iterations, plain.iterations);
+    ExpectSolution(x2);
+}
+
+/**
+ * @brief Тест: BiCGSTAB решает несимметричную систему, в том числе с ILU(0).
+ */
+TEST(TSolvers, bicgstab_solves_nonsymmetric_system)
+{
+    TDynamicMatrix<double> a = MakeNonsymmetric(25);
+    TDynamicVector<double> b = MakeRhs(a);
+    TSolverWorkspace<double> ws(25);
+
+    TDynamicVector<double> x(25);
+    EXPECT_TRUE(BiCGSTAB(a, b, x, ws).converged);
+    ExpectSolution(x);
+
+    TDynamicVector<double> xp(25);
+    EXPECT_TRUE(BiCGSTAB(a, b, xp, ws, {}, TILU0Preconditioner<double>(a)).converged);
+    ExpectSolution(xp);
+}
+
+/**
+ * @brief Тест: решатели работают с пользовательским оператором и с матрицей по столбцам.
+ */
+TEST(TSolvers, solvers_accept_custom_operator_and_column_major_matrix)
+{
+    TTridiagonalOperator op{ 15 };
+    TDynamicMatrix<double> a = MakeSpd(15);
+    TDynamicVector<double> b = MakeRhs(a);
+    TSolverWorkspace<double> ws(15);
+
+    TDynamicVector<double> x(15);
+    EXPECT_TRUE(ConjugateGradient(op, b, x, ws).converged);
+    ExpectSolution(x);
+
+    TDynamicVector<double> diag(15);
+    for (size_t i = 0; i < 15; i++)
+        diag[i] = 4.0;
+    TDynamicVector<double> xj(15);
+    EXPECT_TRUE(BiCGSTAB(op, b, xj, ws, {}, TJacobiPreconditioner<double>(diag)).converged);
+    ExpectSolution(xj);
+
+    TDynamicMatrix<double, TColMajor> ac(a);
+    TDynamicVector<double> xc(15);
+    EXPECT_TRUE(ConjugateGradient(ac, b, xc, ws, {}, TILU0Preconditioner<double>(ac)).converged);
+    ExpectSolution(xc);
+}
+
+// -------------------- Stationary tests --------------------
+
+/**
+ * @brief Тест: методы Якоби и Гаусса-Зейделя сходятся, Гаусс-Зейдель быстрее.
+ */
+TEST(TSolvers, jacobi_and_gauss_seidel_converge)
+{
+    TDynamicMatrix<double> a = MakeNonsymmetric(12);
+    TDynamicVector<double> b = MakeRhs(a);
+    TSolverWorkspace<double> ws(12);
+
+    TDynamicVector<double> xj(12);
+    TSolverResult<double> jac = Jacobi(a, b, xj, ws);
+    EXPECT_TRUE(jac.converged);
+    ExpectSolution(xj);
+
+    TDynamicVector<double> xg(12);
+    TSolverResult<double> gs = GaussSeidel(TDynamicMatrix<double, TColMajor>(a), b, xg, ws);
+    EXPECT_TRUE(gs.converged);
+    EXPECT_LT(gs.iterations, jac.iterations);
+    ExpectSolution(xg);
+}
+
+/**
+ * @brief Тест: нулевой элемент на диагонали для Якоби должен бросать.
+ */
+TEST(TSolvers, jacobi_throws_on_zero_diagonal)
+{
+    TDynamicMatrix<double> a(3);
+    TDynamicVector<double> b(3);
+    TDynamicVector<double> x(3);
+    TSolverWorkspace<double> ws(3);
+    ASSERT_ANY_THROW(Jacobi(a, b, x, ws));
+    ASSERT_ANY_THROW(TJacobiPreconditioner<double>{ a });
+}
+
+/**
+ * @brief Тест: несовпадающие размеры рабочей памяти должны бросать.
+ */
+TEST(TSolvers, throws_on_not_equal_size)
+{
+    TDynamicMatrix<double> a = MakeSpd(4);
+    TDynamicVector<double> b(4);
+    TDynamicVector<double> x(4);
+    TSolverWorkspace<double> ws(5);
+    ASSERT_ANY_THROW(ConjugateGradient(a, b, x, ws));
+}
+
+// -------------------- Options tests --------------------
+
+/**
+ * @brief Тест: callback получает каждую итерацию и может остановить решение.
+ */
+TEST(TSolvers, callback_can_stop_iterations)
+{
+    TDynamicMatrix<double> a = MakeSpd(40);
+    TDynamicVector<double> b = MakeRhs(a);
+    TDynamicVector<double> x(40);
+    TSolverWorkspace<double> ws(40);
+
+    size_t calls = 0;
+    TSolverOptions<double> opt;
+    opt.callback = [&calls](size_t it, double) { calls++; return it < 3; };
+    TSolverResult<double> res = ConjugateGradient(a, b, x, ws, opt);
+    EXPECT_EQ(3u, calls);
+    EXPECT_EQ(3u, res.iterations);
+    EXPECT_FALSE(res.converged);
+}
+
+/**
+ * @brief Тест: max_iterations ограничивает число итераций.
+ */
+TEST(TSolvers, max_iterations_limits_work)
+{
+    TDynamicMatrix<double> a = MakeNonsymmetric(30);
+    TDynamicVector<double> b = MakeRhs(a);
+    TDynamicVector<double> x(30);
+    TSolverWorkspace<double> ws(30);
+
+    TSolverOptions<double> opt;
+    opt.max_iterations = 2;
+    TSolverResult<double> res = Jacobi(a, b, x, ws, opt);
+    EXPECT_FALSE(res.converged);
+    EXPECT_EQ(2u, res.iterations);
+}
+
+/**
+ * @brief Тест: решатели не выделяют буферы векторов - вся память в рабочей области и аргументах (сборка с TVECTOR_COUNT_ALLOCATIONS).
+ */
+TEST(TSolvers, iterations_do_not_allocate)
+{
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+    TDynamicMatrix<double> a = MakeNonsymmetric(50);
+    TDynamicMatrix<double> spd = MakeSpd(50);
+    TDynamicVector<double> b = MakeRhs(a);
+    TDynamicVector<double> bs = MakeRhs(spd);
+    TSolverWorkspace<double> ws(50);
+    TILU0Preconditioner<double> ilu(a);
+    TJacobiPreconditioner<double> jac(spd);
+
+    TSolverOptions<double> opt;
+    opt.rel_tol = 1e-14;
+    TDynamicVector<double> x(50);
+
+    size_t before = GetVectorAllocationCount();
+    ConjugateGradient(spd, bs, x, ws, opt, jac);
+    EXPECT_EQ(before, GetVectorAllocationCount());
+
+    for (size_t i = 0; i < 50; i++) x[i] = 0.0;
+    before = GetVectorAllocationCount();
+    BiCGSTAB(a, b, x, ws, opt, ilu);
+    EXPECT_EQ(before, GetVectorAllocationCount());
+
+    for (size_t i = 0; i < 50; i++) x[i] = 0.0;
+    before = GetVectorAllocationCount();
+    Jacobi(a, b, x, ws, opt);
+    EXPECT_EQ(before, GetVectorAllocationCount());
+
+    for (size_t i = 0; i < 50; i++) x[i] = 0.0;
+    before = GetVectorAllocationCount();
+    GaussSeidel(a, b, x, ws, opt);
+    EXPECT_EQ(before, GetVectorAllocationCount());
+
+    // счётчик видит временные векторы
+    TDynamicVector<double> sum = x + x;
+    EXPECT_EQ(before + 1, GetVectorAllocationCount());
+#else
+    GTEST_SKIP() << "built without TVECTOR_COUNT_ALLOCATIONS";
+#endif
+}
+
+/**
+ * @brief Тест: между итерациями решателя с предобусловливателем и рабочей областью нет выделений (сборка с TVECTOR_COUNT_ALLOCATIONS).
+ */
+TEST(TSolvers, preconditioned_iterations_do_not_allocate)
+{
+#ifdef TVECTOR_COUNT_ALLOCATIONS
+    TDynamicMatrix<double> a = MakeNonsymmetric(40);
+    TDynamicVector<double> b = MakeRhs(a);
+    TDynamicVector<double> x(40);
+    TSolverWorkspace<double> ws(40);
+    TILU0Preconditioner<double> ilu(a);
+
+    // счётчик после первой итерации и число итераций, на которых он изменился
+    size_t first = 0;
+    size_t changed = 0;
+    TSolverOptions<double> opt;
+    opt.rel_tol = 1e-14;
+    opt.callback = [&](size_t iteration, double)
+    {
+        size_t now = GetVectorAllocationCount();
+        if (iteration == 1)
+            first = now;
+        else if (now != first)
+            changed++;
+        return true;
+    };
+
+    TSolverResult<double> res = BiCGSTAB(a, b, x, ws, opt, ilu);
+    EXPECT_TRUE(res.converged);
+    EXPECT_LT(1u, res.iterations);
+    EXPECT_EQ(0u, changed);
+#else
+    GTEST_SKIP() << "built without TVECTOR_COUNT_ALLOCATIONS";
+#endif
+}
+
+// End of tests
@@ -0,0 +1,191 @@
+﻿#include "TMatrix.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+// -------------------- Helpers --------------------
+
+// запись включена на время теста, после - выключена и очищена
+struct TTracingSession
+{
+    TTracingSession()
+    {
+        ClearTrace();
+        SetTracingEnabled(true);
+    }
+    ~TTracingSession()
+    {
+        SetTracingEnabled(false);
+        SetTraceMaxDepth(1);
+        ClearTrace();
+    }
+};
+
+static const TTraceStats* FindStats(const std::vector<TTraceStats>& stats, const std::string& name, unsigned size_class)
+{
+    for (const TTraceStats& s : stats)
+        if (s.name == name && s.size_class == size_class)
+            return &s;
+    return nullptr;
+}
+
+// -------------------- Recording tests --------------------
+
+/**
+ * @brief Тест: при выключенной записи замеры ничего не записывают.
+ */
+TEST(TTrace, disabled_tracing_records_nothing)
+{
+    ClearTrace();
+    SetTracingEnabled(false);
+    {
+        TTraceScope scope("disabled", 10);
+    }
+    EXPECT_TRUE(GetTraceStats().empty());
+}
+
+/**
+ * @brief Тест: гистограммы задержек ведутся отдельно по классам размера.
+ */
+TEST(TTrace, histograms_are_bucketed_by_size_class)
+{
+    TTracingSession session;
+    for (int i = 0; i < 3; i++)
+    {
+        TTraceScope scope("op", 5);
+    }
+    {
+        TTraceScope scope("op", 1000);
+    }
+
+    std::vector<TTraceStats> stats = GetTraceStats();
+    ASSERT_EQ(2u, stats.size());
+    const TTraceStats* small = FindStats(stats, "op", TraceSizeClass(5));
+    const TTraceStats* large = FindStats(stats, "op", TraceSizeClass(1000));
+    ASSERT_NE(nullptr, small);
+    ASSERT_NE(nullptr, large);
+    EXPECT_EQ(3u, TraceSizeClass(5));
+    EXPECT_EQ(10u, TraceSizeClass(1000));
+    EXPECT_EQ(3u, small->count);
+    EXPECT_EQ(1u, large->count);
+
+    std::uint64_t in_buckets = 0;
+    for (std::uint64_t c : small->latency)
+        in_buckets += c;
+    EXPECT_EQ(3u, in_buckets);
+    EXPECT_LE(small->Percentile(0.99), small->max_ns);
+    EXPECT_LE(small->max_ns, small->total_ns);
+}
+
+/**
+ * @brief Тест: вложенные замеры записываются только до заданной глубины.
+ */
+TEST(TTrace, nested_scopes_respect_max_depth)
+{
+    TTracingSession session;
+    {
+        TTraceScope outer("outer", 1);
+        TTraceScope inner("inner", 1);
+    }
+    std::vector<TTraceStats> shallow = GetTraceStats();
+    EXPECT_EQ(nullptr, FindStats(shallow, "inner", 1));
+    ASSERT_NE(nullptr, FindStats(shallow, "outer", 1));
+
+    SetTraceMaxDepth(0);
+    {
+        TTraceScope outer("outer", 1);
+        TTraceScope inner("inner", 1);
+    }
+    std::vector<TTraceStats> stats = GetTraceStats();
+    ASSERT_NE(nullptr, FindStats(stats, "inner", 1));
+    EXPECT_EQ(2u, FindStats(stats, "outer", 1)->count);
+}
+
+/**
+ * @brief Тест: записи из нескольких потоков объединяются, в том числе из потоков, завершившихся до экспорта.
+ */
+TEST(TTrace, records_from_threads_are_merged)
+{
+    TTracingSession session;
+    for (int round = 0; round < 2; round++)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++)
+        {
+            threads.emplace_back([]
+            {
+                for (int i = 0; i < 100; i++)
+                {
+                    TTraceScope scope("threaded", 64);
+                }
+            });
+        }
+        for (std::thread& t : threads)
+            t.join();
+    }
+    std::vector<TTraceStats> merged = GetTraceStats();
+    const TTraceStats* stats = FindStats(merged, "threaded", TraceSizeClass(64));
+    ASSERT_NE(nullptr, stats);
+    EXPECT_EQ(800u, stats->count);
+    EXPECT_EQ(0u, GetTraceDroppedEvents());
+}
+
+// -------------------- Export tests --------------------
+
+/**
+ * @brief Тест: экспорт в Chrome trace содержит по событию на замер, сводка - строку на операцию и класс.
+ */
+TEST(TTrace, exports_chrome_trace_and_summary)
+{
+    TTracingSession session;
+    {
+        TTraceScope scope("export \"quoted\"", 6);
+    }
+    {
+        TTraceScope scope("export \"quoted\"", 6);
+    }
+
+    std::ostringstream json;
+    WriteChromeTrace(json);
+    std::string text = json.str();
+    EXPECT_EQ(0u, text.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, text.find("\"name\":\"export \\\"quoted\\\"\""));
+    EXPECT_NE(std::string::npos, text.find("\"args\":{\"n\":6}"));
+    size_t events = 0;
+    for (size_t pos = text.find("\"ph\":\"X\""); pos != std::string::npos; pos = text.find("\"ph\":\"X\"", pos + 1))
+        events++;
+    EXPECT_EQ(2u, events);
+
+    std::ostringstream summary;
+    WriteTraceSummary(summary);
+    EXPECT_NE(std::string::npos, summary.str().find("export \"quoted\" | [4, 8) | 2 |"));
+}
+
+/**
+ * @brief Тест: операторы матриц записываются одним событием на вызов (сборка с TVECTOR_ENABLE_TRACING).
+ */
+TEST(TTrace, matrix_operators_are_instrumented)
+{
+#ifdef TVECTOR_ENABLE_TRACING
+    TDynamicMatrix<int> a(20), b(20);
+    TTracingSession session;
+    TDynamicMatrix<int> c = a * b;
+    TDynamicMatrix<int> d = a + b;
+
+    std::vector<TTraceStats> stats = GetTraceStats();
+    ASSERT_NE(nullptr, FindStats(stats, "TDynamicMatrix::operator*(matrix)", TraceSizeClass(20)));
+    ASSERT_NE(nullptr, FindStats(stats, "TDynamicMatrix::operator+", TraceSizeClass(20)));
+    EXPECT_EQ(nullptr, FindStats(stats, "TDynamicVector::operator+(vector)", TraceSizeClass(20)));
+
+    SetTraceMaxDepth(2);
+    d = a + b;
+    std::vector<TTraceStats> nested = GetTraceStats();
+    const TTraceStats* lines = FindStats(nested, "TDynamicVector::operator+(vector)", TraceSizeClass(20));
+    ASSERT_NE(nullptr, lines);
+    EXPECT_EQ(20u, lines->count);
+#else
+    GTEST_SKIP() << "built without TVECTOR_ENABLE_TRACING";
+#endif
+}
+
+// End of tests
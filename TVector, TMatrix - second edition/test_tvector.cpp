@@ -458,4 +458,378 @@ TEST(TDynamicVector, can_swap_vectors)
     EXPECT_EQ(v1, v_copy);
 }
 
+
+// -------------------- Limits and allocation tests --------------------
+
+/**
+ * @brief :       .
+ */
+TEST(TDynamicVector, max_vector_size_is_configurable_at_runtime)
+{
+    size_t saved = GetMaxVectorSize();
+    SetMaxVectorSize(10);
+    ASSERT_ANY_THROW(TDynamicVector<int> v(11));
+    ASSERT_NO_THROW(TDynamicVector<int> v(10));
+    SetMaxVectorSize(saved);
+}
+
+/**
+ * @brief :      std::length_error.
+ */
+TEST(TDynamicVector, throws_length_error_on_byte_size_overflow)
+{
+    size_t saved = GetMaxVectorSize();
+    SetMaxVectorSize(std::numeric_limits<size_t>::max());
+    ASSERT_THROW(TDynamicVector<double> v(std::numeric_limits<size_t>::max() / 4), std::length_error);
+    SetMaxVectorSize(saved);
+}
+
+/**
+ * @brief :    (FirstTouch  Interleaved)  .
+ */
+TEST(TDynamicVector, parallel_initialized_vector_is_zeroed)
+{
+    size_t saved = GetParallelInitThreshold();
+    SetParallelInitThreshold(0);
+    for (TAllocPolicy policy : { TAllocPolicy::FirstTouch, TAllocPolicy::Interleaved })
+    {
+        SetAllocPolicy(policy);
+        TDynamicVector<double> v(100000);
+        bool all_zero = true;
+        for (size_t i = 0; i < v.GetSize(); i++)
+            all_zero = all_zero && v[i] == 0.0;
+        EXPECT_TRUE(all_zero);
+    }
+    SetAllocPolicy(TAllocPolicy::FirstTouch);
+    SetParallelInitThreshold(saved);
+}
+
+
+// -------------------- Fast copy and comparison tests --------------------
+
+/**
+ * @brief :        .
+ */
+TEST(TDynamicVector, compare_detects_difference_in_last_element)
+{
+    TDynamicVector<long long> v(1000);
+    for (size_t i = 0; i < v.GetSize(); i++)
+        v[i] = i * 7;
+    TDynamicVector<long long> v1(v);
+    EXPECT_EQ(v, v1);
+    v1[999] += 1;
+    EXPECT_NE(v, v1);
+}
+
+/**
+ * @brief :      (0.0 == -0.0).
+ */
+TEST(TDynamicVector, compare_floating_vectors_by_value)
+{
+    TDynamicVector<double> v(3);
+    TDynamicVector<double> v1(3);
+    v[1] = 0.0;
+    v1[1] = -0.0;
+    EXPECT_EQ(v, v1);
+}
+
+/**
+ * @brief :       .
+ */
+TEST(TDynamicVector, assigned_trivial_vector_is_equal_to_source)
+{
+    TDynamicVector<double> v(50);
+    for (size_t i = 0; i < v.GetSize(); i++)
+        v[i] = i * 0.5;
+    TDynamicVector<double> v1(10);
+    v1 = v;
+    EXPECT_EQ(v, v1);
+}
+
+/**
+ * @brief :   .
+ */
+TEST(TDynamicVector, equals_approx_respects_tolerance)
+{
+    TDynamicVector<double> v(37);
+    for (size_t i = 0; i < v.GetSize(); i++)
+        v[i] = i * 0.1;
+    TDynamicVector<double> v1(v);
+    v1[36] += 1e-9;
+    EXPECT_TRUE(v.EqualsApprox(v1, 1e-6));
+    v1[20] += 1e-3;
+    EXPECT_FALSE(v.EqualsApprox(v1, 1e-6));
+}
+
+/**
+ * @brief : NaN       .
+ */
+TEST(TDynamicVector, equals_approx_rejects_nan)
+{
+    TDynamicVector<double> v(20);
+    TDynamicVector<double> v1(20);
+    v1[3] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(v.EqualsApprox(v1, 1.0));
+}
+
+/**
+ * @brief :       .
+ */
+TEST(TDynamicVector, policy_operations_match_sequential)
+{
+    SetParallelThreads(4);
+    const size_t n = 10007;
+    TDynamicVector<long long> a(n);
+    TDynamicVector<long long> b(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = (long long)(i % 97) - 40;
+        b[i] = (long long)(i % 13) * 3;
+    }
+
+    EXPECT_EQ(Add(policy::seq, a, b), Add(policy::par, a, b));
+    EXPECT_EQ(Subtract(policy::seq, a, b), Subtract(policy::par_unseq, a, b));
+    EXPECT_EQ(Add(policy::seq, a, 5), Add(policy::par, a, 5));
+    EXPECT_EQ(Subtract(policy::seq, a, 5), Subtract(policy::par, a, 5));
+    EXPECT_EQ(Multiply(policy::seq, a, 3), Multiply(policy::par_unseq, a, 3));
+    EXPECT_EQ(Dot(policy::seq, a, b), Dot(policy::par, a, b));
+    EXPECT_EQ(Dot(policy::seq, a, b), Dot(policy::par_unseq, a, b));
+
+    TDynamicVector<long long> c(1);
+    Copy(policy::par, a, c);
+    EXPECT_TRUE(Equal(policy::par, a, c));
+    c[n - 1]++;
+    EXPECT_FALSE(Equal(policy::par, a, c));
+    EXPECT_FALSE(Equal(policy::seq, a, c));
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief :          .
+ */
+TEST(TDynamicVector, operators_parallelize_above_auto_threshold)
+{
+    SetParallelThreads(4);
+    size_t saved = GetAutoParallelThreshold();
+    const size_t n = 5003;
+    TDynamicVector<double> a(n);
+    TDynamicVector<double> b(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = 0.5 * i;
+        b[i] = 2.0;
+    }
+
+    TDynamicVector<double> serial_sum = Add(policy::seq, a, b);
+    double serial_dot = Dot(policy::seq, a, b);
+    SetAutoParallelThreshold(0);
+    EXPECT_EQ(serial_sum, a + b);
+    EXPECT_DOUBLE_EQ(serial_dot, a * b);
+    TDynamicVector<double> copy(a);
+    EXPECT_EQ(a, copy);
+    SetAutoParallelThreshold(saved);
+    SetParallelThreads(0);
+}
+
+/**
+ * @brief :         .
+ */
+TEST(TDynamicVector, policy_operations_throw_on_not_equal_size)
+{
+    TDynamicVector<int> a(4);
+    TDynamicVector<int> b(5);
+    ASSERT_ANY_THROW(Add(policy::par, a, b));
+    ASSERT_ANY_THROW(Dot(policy::par_unseq, a, b));
+    EXPECT_FALSE(Equal(policy::par, a, b));
+}
+
+/**
+ * @brief :         .
+ */
+TEST(TDynamicVector, reproducible_dot_is_identical_across_thread_counts)
+{
+    size_t saved = GetAutoParallelThreshold();
+    const size_t n = 20011;
+    TDynamicVector<double> a(n);
+    TDynamicVector<double> b(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = 1.0 / (i + 1) * ((i % 3) ? 1e8 : 1e-8);
+        b[i] = (i % 5) - 2.5;
+    }
+
+    SetAutoParallelThreshold(size_t(-1));
+    const double expected = Dot(policy::reproducible, a, b);
+    SetAutoParallelThreshold(0);
+    for (size_t threads : { 1, 2, 3, 7, 16 })
+    {
+        SetParallelThreads(threads);
+        double result = Dot(policy::reproducible, a, b);
+        EXPECT_EQ(0, std::memcmp(&expected, &result, sizeof(double)));
+    }
+
+    SetReproducibleReductions(true);
+    double via_operator = a * b;
+    EXPECT_EQ(0, std::memcmp(&expected, &via_operator, sizeof(double)));
+    SetReproducibleReductions(false);
+
+    SetParallelThreads(0);
+    SetAutoParallelThreshold(saved);
+    EXPECT_NEAR(Dot(policy::seq, a, b), expected, 1e-6 * std::abs(expected) + 1e-6);
+}
+
+/**
+ * @brief : push_back  emplace_back      O(log n) .
+ */
+TEST(TDynamicVector, push_back_grows_capacity_geometrically)
+{
+    TDynamicVector<int> v(1);
+    size_t reallocations = 0;
+    const int* data = &v[0];
+    for (int i = 1; i < 1000; i++)
+    {
+        if (i % 2 == 0)
+            v.push_back(i);
+        else
+            EXPECT_EQ(i, v.emplace_back(i));
+        if (&v[0] != data)
+        {
+            data = &v[0];
+            reallocations++;
+        }
+    }
+    EXPECT_EQ(1000u, v.GetSize());
+    EXPECT_GE(v.GetCapacity(), v.GetSize());
+    EXPECT_LE(reallocations, 11u);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(i, v[i]);
+
+    //  -    
+    v.shrink_to_fit();
+    v.push_back(v[0]);
+    EXPECT_EQ(0, v[1000]);
+}
+
+/**
+ * @brief : resize  ,     (    ).
+ */
+TEST(TDynamicVector, resize_preserves_elements_and_zeroes_new_ones)
+{
+    TDynamicVector<int> v(5);
+    for (size_t i = 0; i < 5; i++)
+        v[i] = int(i) + 1;
+    v.resize(2);
+    EXPECT_EQ(2u, v.GetSize());
+    EXPECT_EQ(5u, v.GetCapacity());
+    v.resize(8);
+    EXPECT_EQ(8u, v.GetSize());
+    EXPECT_EQ(1, v[0]);
+    EXPECT_EQ(2, v[1]);
+    for (size_t i = 2; i < 8; i++)
+        EXPECT_EQ(0, v[i]);
+
+    size_t old_max = GetMaxVectorSize();
+    SetMaxVectorSize(10);
+    ASSERT_THROW(v.resize(11), std::length_error);
+    ASSERT_THROW(v.reserve(11), std::length_error);
+    SetMaxVectorSize(old_max);
+    EXPECT_EQ(8u, v.GetSize());
+}
+
+/**
+ * @brief :     , shrink_to_fit  .
+ */
+TEST(TDynamicVector, assignment_reuses_capacity)
+{
+    TDynamicVector<double> v(100);
+    const double* data = &v[0];
+    TDynamicVector<double> small(10);
+    for (size_t i = 0; i < 10; i++)
+        small[i] = i * 1.5;
+
+    v = small;
+    EXPECT_EQ(data, &v[0]);
+    EXPECT_EQ(10u, v.GetSize());
+    EXPECT_EQ(100u, v.GetCapacity());
+    EXPECT_EQ(small, v);
+
+    v.reserve(50);
+    EXPECT_EQ(data, &v[0]);
+    v.shrink_to_fit();
+    EXPECT_EQ(10u, v.GetCapacity());
+    EXPECT_EQ(small, v);
+
+    TDynamicVector<double> big(20);
+    v = big;
+    EXPECT_EQ(20u, v.GetCapacity());
+    EXPECT_EQ(big, v);
+}
+
+/**
+ * @brief :    -     , swap  .
+ */
+TEST(TDynamicVector, capacity_works_for_nested_vectors_and_swap)
+{
+    TDynamicVector<TDynamicVector<int>> v(3);
+    v[2] = TDynamicVector<int>(1000);
+    v.resize(1);
+    v.resize(3);
+    EXPECT_EQ(1u, v[2].GetSize());
+
+    TDynamicVector<int> a(4), b(2);
+    a.resize(1);
+    a.swap(a, b);
+    EXPECT_EQ(2u, a.GetSize());
+    EXPECT_EQ(2u, a.GetCapacity());
+    EXPECT_EQ(1u, b.GetSize());
+    EXPECT_EQ(4u, b.GetCapacity());
+}
+
+/**
+ * @brief : resize(0) ,     ,   .
+ */
+TEST(TDynamicVector, resize_to_zero_is_rejected)
+{
+    TDynamicVector<double> v(4);
+    for (size_t i = 0; i < 4; i++)
+        v[i] = double(i);
+    v.resize(1);
+    ASSERT_THROW(v.resize(0), std::out_of_range);
+    EXPECT_EQ(1u, v.GetSize());
+    v.shrink_to_fit();
+    EXPECT_EQ(1u, v.GetCapacity());
+
+    TDynamicVector<double> w(3);
+    Copy(policy::seq, v, w);
+    EXPECT_EQ(v, w);
+    EXPECT_EQ(0.0, (v + v)[0]);
+    EXPECT_EQ(1u, (v * 2.0).GetSize());
+    v[0] = 1.5;
+    EXPECT_EQ(3.0, (v + v)[0]);
+    EXPECT_EQ(2.25, v * v);
+}
+
+/**
+ * @brief : Copy     ,   ()    .
+ */
+TEST(TDynamicVector, copy_handles_growth_and_moved_from_source)
+{
+    TDynamicVector<int> src(100);
+    for (size_t i = 0; i < src.GetSize(); i++)
+        src[i] = static_cast<int>(i) * 3;
+
+    TDynamicVector<int> small(2);
+    Copy(policy::par, src, small);
+    EXPECT_EQ(src, small);
+    EXPECT_EQ(100u, small.GetCapacity());
+
+    TDynamicVector<int> taken(std::move(src));
+    TDynamicVector<int> dst(5);
+    ASSERT_NO_THROW(Copy(policy::seq, src, dst));
+    EXPECT_EQ(0u, dst.GetSize());
+    EXPECT_EQ(src, dst);
+    ASSERT_NO_THROW(Copy(policy::seq, src, small));
+    EXPECT_EQ(0u, small.GetSize());
+}
+
 // End of tests